@@ -0,0 +1,93 @@
+"""Compare an svm_benchmark report with a baseline report.
+
+Fails (exit code 1) when, for any dataset and size of the baseline, ado:
+  - lost more than --max-accuracy-drop accuracy,
+  - fits or predicts more than --max-slowdown times slower,
+  - uses more than --max-memory-growth times the baseline peak RSS,
+and, in the report itself, when ado is less accurate than libsvm by more than
+--libsvm-accuracy-margin or when the decision function of the int8 quantized
+ado model deviates by more than --max-quantized-error.
+
+Usage: python check_report.py REPORT.json --baseline BASELINE.json
+"""
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as report:
+        results = json.load(report)["results"]
+    return {(r["dataset"], r["n_train"], r["solver"]): r for r in results}
+
+
+def check(report, baseline, args):
+    failures = []
+    for key, expected in baseline.items():
+        dataset, n_train, solver = key
+        if solver != "ado":
+            continue
+        name = "{} (n_train={})".format(dataset, n_train)
+        actual = report.get(key)
+        if actual is None:
+            failures.append("{}: missing from the report".format(name))
+            continue
+
+        if actual["accuracy"] < expected["accuracy"] - args.max_accuracy_drop:
+            failures.append("{}: accuracy {:.4f} < baseline {:.4f}".format(
+                name, actual["accuracy"], expected["accuracy"]))
+        if actual["fit_seconds"] > args.max_slowdown * expected["fit_seconds"]:
+            failures.append("{}: fit {:.3f} s > baseline {:.3f} s".format(
+                name, actual["fit_seconds"], expected["fit_seconds"]))
+        if (actual["predict_rows_per_second"] * args.max_slowdown <
+                expected["predict_rows_per_second"]):
+            failures.append("{}: predict {:.0f} rows/s < baseline {:.0f}"
+                            .format(name, actual["predict_rows_per_second"],
+                                    expected["predict_rows_per_second"]))
+        if (actual["peak_rss_kb"] >
+                args.max_memory_growth * expected["peak_rss_kb"]):
+            failures.append("{}: peak RSS {} KB > baseline {} KB".format(
+                name, actual["peak_rss_kb"], expected["peak_rss_kb"]))
+
+    for (dataset, n_train, solver), actual in report.items():
+        error = actual.get("quantized_max_error")
+        if error is not None and error > args.max_quantized_error:
+            failures.append(
+                "{} (n_train={}): quantized max error {:.4f} > {:.4f}".format(
+                    dataset, n_train, error, args.max_quantized_error))
+
+        reference = report.get((dataset, n_train, "libsvm"))
+        if solver != "ado" or reference is None:
+            continue
+        if (actual["accuracy"] <
+                reference["accuracy"] - args.libsvm_accuracy_margin):
+            failures.append(
+                "{} (n_train={}): accuracy {:.4f} < libsvm {:.4f}".format(
+                    dataset, n_train, actual["accuracy"],
+                    reference["accuracy"]))
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("report")
+    parser.add_argument("--baseline", required=True)
+    parser.add_argument("--max-slowdown", type=float, default=1.5)
+    parser.add_argument("--max-accuracy-drop", type=float, default=0.01)
+    parser.add_argument("--max-memory-growth", type=float, default=1.5)
+    parser.add_argument("--libsvm-accuracy-margin", type=float, default=0.02)
+    parser.add_argument("--max-quantized-error", type=float, default=0.05)
+    args = parser.parse_args()
+
+    failures = check(load_results(args.report), load_results(args.baseline),
+                     args)
+    for failure in failures:
+        print("FAIL " + failure)
+    if failures:
+        return 1
+    print("OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
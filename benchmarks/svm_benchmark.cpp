@@ -0,0 +1,605 @@
+/**
+ * Training and inference benchmark of ado's SMO solver against libsvm.
+ *
+ * Every dataset is generated (or loaded) at each requested size, fitted with
+ * ado and, when the libsvm command line tools (svm-train, svm-predict) are
+ * found, with libsvm using the same C, tolerance and kernel. The fit time,
+ * SMO iterations, support vectors, peak RSS, prediction throughput and test
+ * accuracy of every run, and the max error of the int8 quantized ado model,
+ * are written to a JSON report, which check_report.py compares with a
+ * baseline report.
+ *
+ * Usage: svm_benchmark --output REPORT.json [--sizes 1000,4000]
+ *                      [--occupancy DIR] [--libsvm DIR] [--seed S]
+ *                      [--C C] [--tol TOL] [--max-steps STEPS]
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ado/core/kernel.h"
+#include "ado/core/quantized_svm.h"
+#include "ado/core/svm.h"
+#include "ado/preprocessing/scaler.h"
+#include "ado/types.h"
+#include "ado/utils/io.h"
+#include "ado/utils/logger.h"
+
+using ado::Float;
+using ado::FloatArray;
+using ado::core::KernelRBF;
+using ado::core::QuantizedSVM;
+using ado::core::SVM;
+using ado::preprocessing::MinMaxScaler;
+using ado::utils::load_data;
+using ado::utils::Logger;
+using ado::utils::LogLevel;
+using ado::utils::LogStreamHandler;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string output;
+  std::string occupancy_dir;
+  std::string libsvm_dir;
+  std::vector<std::size_t> sizes = {1000, 4000};
+  std::size_t seed = 16;
+  Float C = 1.0;
+  Float tol = 1e-3;
+  std::size_t max_steps = 1000;
+};
+
+struct Dataset {
+  std::string name;
+  FloatArray x_train;
+  FloatArray y_train;
+  FloatArray x_test;
+  FloatArray y_test;
+};
+
+struct RunResult {
+  std::string solver;
+  double fit_seconds = 0.0;
+  std::size_t iterations = 0;
+  std::size_t n_support = 0;
+  long peak_rss_kb = 0;
+  double predict_rows_per_second = 0.0;
+  double accuracy = 0.0;
+  // Max deviation of the QuantizedSVM decision function on the test set, ado
+  // only.
+  double quantized_max_error = 0.0;
+};
+
+double seconds_since(const Clock::time_point& start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Reset the peak RSS of the process, so that VmHWM reports the peak
+ * of the next run only (Linux, no-op elsewhere).
+ */
+void reset_peak_rss() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if (clear_refs) clear_refs << "5";
+}
+
+long peak_rss_kb() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::stol(line.substr(6));
+    }
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * @brief Two Gaussian classes of n_features dimensions, centered on
+ * +/-separation along every axis, with a fraction of flipped labels.
+ */
+void gaussian_classes(const std::size_t n_samples,
+                      const std::size_t n_features, const Float separation,
+                      const Float label_noise, std::mt19937& engine,
+                      FloatArray& x, FloatArray& y) {
+  std::normal_distribution<Float> normal(0.0, 1.0);
+  std::uniform_real_distribution<Float> uniform(0.0, 1.0);
+  x = xt::empty<Float>({n_samples, n_features});
+  y = xt::empty<Float>({n_samples});
+  for (std::size_t i = 0; i < n_samples; ++i) {
+    const Float label = (i % 2 == 0) ? 1.0 : -1.0;
+    for (std::size_t f = 0; f < n_features; ++f) {
+      x.data()[i * n_features + f] = label * separation + normal(engine);
+    }
+    y.data()[i] = (uniform(engine) < label_noise) ? -label : label;
+  }
+}
+
+/**
+ * @brief High-dimensional rows with 2% of non-zero features, labelled by a
+ * random hyperplane through their mean.
+ */
+void sparse_classes(const std::size_t n_samples, const std::size_t n_features,
+                    std::mt19937& engine, const std::vector<Float>& w,
+                    FloatArray& x, FloatArray& y) {
+  std::uniform_real_distribution<Float> uniform(0.0, 1.0);
+  x = xt::empty<Float>({n_samples, n_features});
+  y = xt::empty<Float>({n_samples});
+  for (std::size_t i = 0; i < n_samples; ++i) {
+    Float projection = 0.0;
+    for (std::size_t f = 0; f < n_features; ++f) {
+      const Float value = (uniform(engine) < 0.02) ? uniform(engine) : 0.0;
+      x.data()[i * n_features + f] = value;
+      projection += w[f] * (value - 0.01);
+    }
+    y.data()[i] = (projection >= 0.0) ? 1.0 : -1.0;
+  }
+}
+
+/**
+ * @brief Rows [first, first + n_rows) of the occupancy data, the 5 sensor
+ * columns as features and the occupancy as a -1/1 label.
+ */
+void occupancy_rows(const FloatArray& data, const std::size_t first,
+                    const std::size_t n_rows, FloatArray& x, FloatArray& y) {
+  const auto view = ado::make_view(data);
+  x = xt::empty<Float>({n_rows, std::size_t(5)});
+  y = xt::empty<Float>({n_rows});
+  for (std::size_t i = 0; i < n_rows; ++i) {
+    const Float* row = view.row(first + i);
+    std::copy(row, row + 5, x.data() + i * 5);
+    y.data()[i] = (row[5] == 0) ? -1.0 : 1.0;
+  }
+}
+
+void shuffle_rows(FloatArray& data, std::mt19937& engine) {
+  const auto view = ado::make_view(data);
+  for (std::size_t i = view.rows; i > 1; --i) {
+    const std::size_t j =
+        std::uniform_int_distribution<std::size_t>(0, i - 1)(engine);
+    Float* a = data.data() + (i - 1) * view.cols;
+    Float* b = data.data() + j * view.cols;
+    std::swap_ranges(a, a + view.cols, b);
+  }
+}
+
+std::vector<Dataset> make_datasets(const Options& options,
+                                   const std::size_t n_train) {
+  const std::size_t n_test = std::max<std::size_t>(500, n_train / 4);
+  std::mt19937 engine(options.seed + n_train);
+  std::vector<Dataset> datasets;
+
+  Dataset separable;
+  separable.name = "separable";
+  gaussian_classes(n_train, 10, 2.0, 0.0, engine, separable.x_train,
+                   separable.y_train);
+  gaussian_classes(n_test, 10, 2.0, 0.0, engine, separable.x_test,
+                   separable.y_test);
+  datasets.push_back(std::move(separable));
+
+  Dataset overlapping;
+  overlapping.name = "overlapping";
+  gaussian_classes(n_train, 10, 0.3, 0.05, engine, overlapping.x_train,
+                   overlapping.y_train);
+  gaussian_classes(n_test, 10, 0.3, 0.05, engine, overlapping.x_test,
+                   overlapping.y_test);
+  datasets.push_back(std::move(overlapping));
+
+  // Far from the origin, where the quantization has to center the features.
+  Dataset shifted;
+  shifted.name = "shifted";
+  gaussian_classes(n_train, 10, 2.0, 0.0, engine, shifted.x_train,
+                   shifted.y_train);
+  gaussian_classes(n_test, 10, 2.0, 0.0, engine, shifted.x_test,
+                   shifted.y_test);
+  shifted.x_train += 100.0;
+  shifted.x_test += 100.0;
+  datasets.push_back(std::move(shifted));
+
+  Dataset sparse;
+  sparse.name = "sparse_highdim";
+  std::normal_distribution<Float> normal(0.0, 1.0);
+  std::vector<Float> w(1000);
+  for (auto& value : w) value = normal(engine);
+  sparse_classes(n_train, w.size(), engine, w, sparse.x_train, sparse.y_train);
+  sparse_classes(n_test, w.size(), engine, w, sparse.x_test, sparse.y_test);
+  datasets.push_back(std::move(sparse));
+
+  if (!options.occupancy_dir.empty()) {
+    FloatArray train = load_data(options.occupancy_dir + "/datatraining.csv");
+    FloatArray test = load_data(options.occupancy_dir + "/datatest2.csv");
+    shuffle_rows(train, engine);
+    shuffle_rows(test, engine);
+
+    Dataset occupancy;
+    occupancy.name = "occupancy";
+    occupancy_rows(train, 0, std::min(n_train, train.shape(0)),
+                   occupancy.x_train, occupancy.y_train);
+    occupancy_rows(test, 0, std::min(n_test, test.shape(0)), occupancy.x_test,
+                   occupancy.y_test);
+    MinMaxScaler scaler;
+    scaler.fit(occupancy.x_train);
+    scaler.transform_inplace(occupancy.x_train);
+    scaler.transform_inplace(occupancy.x_test);
+    datasets.push_back(std::move(occupancy));
+  }
+  return datasets;
+}
+
+double accuracy(const Float* y_hat, const FloatArray& y) {
+  std::size_t correct = 0;
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    if (y_hat[i] == y.data()[i]) ++correct;
+  }
+  return static_cast<double>(correct) / y.size();
+}
+
+RunResult run_ado(const Dataset& dataset, const Options& options) {
+  RunResult result;
+  result.solver = "ado";
+  const Float gamma = 1.0 / dataset.x_train.shape(1);
+
+  reset_peak_rss();
+  SVM svm(options.C, options.tol, std::make_unique<KernelRBF>(gamma),
+          options.max_steps, options.seed);
+  const auto fit_start = Clock::now();
+  svm.fit(dataset.x_train, dataset.y_train);
+  result.fit_seconds = seconds_since(fit_start);
+  result.peak_rss_kb = peak_rss_kb();
+  result.iterations = svm.iterations();
+  result.n_support = svm.alphas().size();
+
+  // Repeat the predictions for at least 200 ms to get a stable throughput.
+  const auto x_test = ado::make_view(dataset.x_test);
+  std::vector<Float> y_hat(x_test.rows);
+  std::size_t n_rows = 0;
+  const auto predict_start = Clock::now();
+  do {
+    svm.predict(x_test, y_hat.data());
+    n_rows += x_test.rows;
+  } while (seconds_since(predict_start) < 0.2);
+  result.predict_rows_per_second = n_rows / seconds_since(predict_start);
+  result.accuracy = accuracy(y_hat.data(), dataset.y_test);
+  result.quantized_max_error =
+      QuantizedSVM(svm).max_error(svm, dataset.x_test);
+  return result;
+}
+
+void write_libsvm(const FloatArray& x, const FloatArray& y,
+                  const std::string& path) {
+  std::ofstream output(path);
+  if (!output) {
+    throw std::runtime_error("Unable to open file " + path);
+  }
+  output << std::setprecision(std::numeric_limits<Float>::max_digits10);
+  const auto view = ado::make_view(x);
+  for (std::size_t i = 0; i < view.rows; ++i) {
+    output << y.data()[i];
+    for (std::size_t f = 0; f < view.cols; ++f) {
+      if (view.row(i)[f] != 0) output << ' ' << f + 1 << ':' << view.row(i)[f];
+    }
+    output << '\n';
+  }
+}
+
+/**
+ * @brief Run a command, capture its standard output and its peak RSS.
+ *
+ * @return int exit status, 127 if the command could not be started.
+ */
+int run_command(const std::vector<std::string>& args, std::string& output,
+                long& peak_rss_kb) {
+  int pipe_fds[2];
+  if (pipe(pipe_fds) != 0) {
+    throw std::runtime_error("Unable to create a pipe.");
+  }
+  const pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error("Unable to fork.");
+  }
+  if (pid == 0) {
+    dup2(pipe_fds[1], STDOUT_FILENO);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    std::vector<char*> argv;
+    for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+
+  close(pipe_fds[1]);
+  output.clear();
+  char buffer[4096];
+  ssize_t size;
+  while ((size = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, size);
+  }
+  close(pipe_fds[0]);
+
+  int status = 0;
+  struct rusage usage;
+  wait4(pid, &status, 0, &usage);
+  peak_rss_kb = usage.ru_maxrss;
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * @brief Removes the files of a run when it goes out of scope, including
+ * when the run throws.
+ */
+struct ScopedFiles {
+  ~ScopedFiles() {
+    for (const auto& path : this->paths) std::remove(path.c_str());
+  }
+
+  std::vector<std::string> paths;
+};
+
+std::string match(const std::string& text, const std::string& pattern) {
+  std::smatch groups;
+  if (!std::regex_search(text, groups, std::regex(pattern))) {
+    throw std::runtime_error("Unexpected libsvm output: " + text);
+  }
+  return groups[1];
+}
+
+/**
+ * @brief Fit and evaluate libsvm (C-SVC, RBF kernel) through its command
+ * line tools. The prediction throughput includes the parsing of the test
+ * file by svm-predict.
+ *
+ * @return bool false if the libsvm tools are not available.
+ */
+bool run_libsvm(const Dataset& dataset, const Options& options,
+                const std::string& directory, RunResult& result) {
+  const std::string prefix =
+      options.libsvm_dir.empty() ? "" : options.libsvm_dir + "/";
+  const std::string train_path = directory + "/" + dataset.name + ".train";
+  const std::string test_path = directory + "/" + dataset.name + ".test";
+  const std::string model_path = directory + "/" + dataset.name + ".model";
+  const std::string output_path = directory + "/" + dataset.name + ".out";
+  const ScopedFiles files{{train_path, test_path, model_path, output_path}};
+  write_libsvm(dataset.x_train, dataset.y_train, train_path);
+  write_libsvm(dataset.x_test, dataset.y_test, test_path);
+
+  std::ostringstream gamma;
+  gamma << std::setprecision(std::numeric_limits<Float>::max_digits10)
+        << 1.0 / dataset.x_train.shape(1);
+  std::string output;
+  long peak_rss = 0;
+
+  const auto fit_start = Clock::now();
+  const int status = run_command(
+      {prefix + "svm-train", "-s", "0", "-t", "2", "-g", gamma.str(), "-c",
+       std::to_string(options.C), "-e", std::to_string(options.tol), "-q",
+       train_path, model_path},
+      output, peak_rss);
+  if (status == 127) return false;
+  if (status != 0) {
+    throw std::runtime_error("svm-train failed on " + dataset.name);
+  }
+
+  result.solver = "libsvm";
+  result.fit_seconds = seconds_since(fit_start);
+  result.peak_rss_kb = peak_rss;
+
+  // -q silences the iterations, rerun verbosely outside the timed section.
+  run_command({prefix + "svm-train", "-s", "0", "-t", "2", "-g", gamma.str(),
+               "-c", std::to_string(options.C), "-e",
+               std::to_string(options.tol), train_path, model_path},
+              output, peak_rss);
+  result.iterations = std::stoul(match(output, "#iter = ([0-9]+)"));
+  result.n_support = std::stoul(match(output, "nSV = ([0-9]+)"));
+
+  const auto predict_start = Clock::now();
+  if (run_command({prefix + "svm-predict", test_path, model_path, output_path},
+                  output, peak_rss) != 0) {
+    throw std::runtime_error("svm-predict failed on " + dataset.name);
+  }
+  result.predict_rows_per_second =
+      dataset.y_test.size() / seconds_since(predict_start);
+  result.accuracy = std::stod(match(output, "Accuracy = ([0-9.]+)%")) / 100;
+  return true;
+}
+
+void write_report(std::ostream& output, const Options& options,
+                  const std::vector<std::string>& records) {
+  output << "{\n  \"config\": {\"seed\": " << options.seed
+         << ", \"C\": " << options.C << ", \"tol\": " << options.tol
+         << ", \"max_steps\": " << options.max_steps << ", \"kernel\": "
+         << "\"rbf\"},\n  \"results\": [\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    output << "    " << records[i] << (i + 1 < records.size() ? ",\n" : "\n");
+  }
+  output << "  ]\n}\n";
+}
+
+std::string record(const Dataset& dataset, const RunResult& result) {
+  std::ostringstream json;
+  json << std::setprecision(6) << "{\"dataset\": \"" << dataset.name
+       << "\", \"n_train\": " << dataset.y_train.size()
+       << ", \"n_test\": " << dataset.y_test.size()
+       << ", \"n_features\": " << dataset.x_train.shape(1)
+       << ", \"solver\": \"" << result.solver
+       << "\", \"fit_seconds\": " << result.fit_seconds
+       << ", \"iterations\": " << result.iterations
+       << ", \"n_support\": " << result.n_support
+       << ", \"peak_rss_kb\": " << result.peak_rss_kb
+       << ", \"predict_rows_per_second\": " << result.predict_rows_per_second
+       << ", \"accuracy\": " << result.accuracy;
+  if (result.solver == "ado") {
+    json << ", \"quantized_max_error\": " << result.quantized_max_error;
+  }
+  json << "}";
+  return json.str();
+}
+
+void usage() {
+  std::cerr << "Usage: svm_benchmark --output REPORT.json "
+               "[--sizes 1000,4000]\n"
+               "                     [--occupancy DIR] [--libsvm DIR] "
+               "[--seed S]\n"
+               "                     [--C C] [--tol TOL] "
+               "[--max-steps STEPS]\n";
+}
+
+bool parse_count(const std::string& value, std::size_t& count) {
+  try {
+    std::size_t end = 0;
+    const unsigned long parsed = std::stoul(value, &end);
+    if (end != value.size() || value[0] == '-') return false;
+    count = parsed;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+/**
+ * @brief Parse a strictly positive, finite number.
+ */
+bool parse_positive(const std::string& value, Float& number) {
+  try {
+    std::size_t end = 0;
+    const Float parsed = std::stod(value, &end);
+    if (end != value.size() || !std::isfinite(parsed) || parsed <= 0.0) {
+      return false;
+    }
+    number = parsed;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+/**
+ * @brief Parse a comma-separated list of positive training set sizes.
+ */
+bool parse_sizes(const std::string& value, std::vector<std::size_t>& sizes) {
+  std::vector<std::size_t> parsed;
+  std::istringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    std::size_t size = 0;
+    if (!parse_count(item, size) || size == 0) return false;
+    parsed.push_back(size);
+  }
+  if (parsed.empty()) return false;
+  sizes = std::move(parsed);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto& logger = Logger::get();
+  logger.register_handler(std::make_unique<LogStreamHandler>(LogLevel::Info));
+
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+    const std::string value = argv[i + 1];
+    bool parsed = true;
+    if (arg == "--output") {
+      options.output = value;
+    } else if (arg == "--sizes") {
+      parsed = parse_sizes(value, options.sizes);
+    } else if (arg == "--occupancy") {
+      options.occupancy_dir = value;
+    } else if (arg == "--libsvm") {
+      options.libsvm_dir = value;
+    } else if (arg == "--seed") {
+      parsed = parse_count(value, options.seed);
+    } else if (arg == "--C") {
+      parsed = parse_positive(value, options.C);
+    } else if (arg == "--tol") {
+      parsed = parse_positive(value, options.tol);
+    } else if (arg == "--max-steps") {
+      parsed = parse_count(value, options.max_steps);
+    } else {
+      parsed = false;
+    }
+    if (!parsed) {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.output.empty() || argc % 2 == 0) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  char directory_template[] = "/tmp/ado_benchmark_XXXXXX";
+  const char* directory = mkdtemp(directory_template);
+  if (directory == nullptr) {
+    logger << LogLevel::Error << "Unable to create a temporary directory.";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> records;
+  bool libsvm_available = true;
+  try {
+    for (const std::size_t size : options.sizes) {
+      for (const auto& dataset : make_datasets(options, size)) {
+        const auto ado_result = run_ado(dataset, options);
+        records.push_back(record(dataset, ado_result));
+        logger << LogLevel::Info << dataset.name << " (" << size
+               << "): ado fit " << ado_result.fit_seconds << " s, accuracy "
+               << ado_result.accuracy;
+
+        RunResult libsvm_result;
+        if (libsvm_available &&
+            run_libsvm(dataset, options, directory, libsvm_result)) {
+          records.push_back(record(dataset, libsvm_result));
+          logger << LogLevel::Info << dataset.name << " (" << size
+                 << "): libsvm fit " << libsvm_result.fit_seconds
+                 << " s, accuracy " << libsvm_result.accuracy;
+        } else if (libsvm_available) {
+          libsvm_available = false;
+          logger << LogLevel::Info
+                 << "libsvm tools not found, skipping the comparison.";
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    // The libsvm runs remove their own files.
+    rmdir(directory);
+    logger << LogLevel::Error << e.what();
+    return EXIT_FAILURE;
+  }
+
+  rmdir(directory);
+
+  std::ofstream output(options.output);
+  write_report(output, options, records);
+  if (!output) {
+    logger << LogLevel::Error << "Unable to write " << options.output;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,16 +1,12 @@
+#include "pybind11/numpy.h"
 #include "pybind11/pybind11.h"
-
-#define FORCE_IMPORT_ARRAY
 #include "svm.h"
-#include "xtensor-python/pyarray.hpp"
 
 namespace py = pybind11;
 
 // Python Module and Docstrings
 
 PYBIND11_MODULE(ado, m) {
-  xt::import_numpy();
-
   py::class_<SVM>(m, "SVM")
       .def(py::init<const Float, const Float, const std::string &,
                     const std::size_t, const std::size_t, const Float,
@@ -1,8 +1,61 @@
 #include "svm.h"
 
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+
+namespace py = pybind11;
+
 namespace {
 using ado::core::KernelType;
 
+using CArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+bool is_float64(const py::array &x) {
+  return x.dtype().kind() == 'f' && x.itemsize() == sizeof(double);
+}
+
+bool has_element_strides(const py::array &x, const py::ssize_t dim) {
+  return x.strides(dim) >= 0 &&
+         static_cast<std::size_t>(x.strides(dim)) % sizeof(double) == 0;
+}
+
+// View over x, converted into holder only if its rows are not contiguous
+// float64 values.
+ado::MatrixView matrix_view(const py::array &x, py::array &holder) {
+  if (x.ndim() != 2) {
+    throw std::invalid_argument("Expected an array of shape (N,M).");
+  }
+  const bool in_place =
+      is_float64(x) && has_element_strides(x, 0) &&
+      (x.shape(1) <= 1 || x.strides(1) == sizeof(double));
+  holder = in_place ? x : CArray::ensure(x);
+  if (!holder) {
+    throw std::invalid_argument("Unable to convert the input to float64.");
+  }
+  return ado::MatrixView{static_cast<const double *>(holder.data()),
+                         static_cast<std::size_t>(holder.shape(0)),
+                         static_cast<std::size_t>(holder.shape(1)),
+                         holder.strides(0) / sizeof(double)};
+}
+
+// View over y of shape (N) or (N,1), converted into holder only if needed.
+ado::VectorView vector_view(const py::array &y, py::array &holder) {
+  if (y.ndim() != 1 && !(y.ndim() == 2 && y.shape(1) == 1)) {
+    throw std::invalid_argument("Expected an array of shape (N) or (N,1).");
+  }
+  const bool in_place = is_float64(y) && has_element_strides(y, 0);
+  holder = in_place ? y : CArray::ensure(y);
+  if (!holder) {
+    throw std::invalid_argument("Unable to convert the labels to float64.");
+  }
+  return ado::VectorView{static_cast<const double *>(holder.data()),
+                         static_cast<std::size_t>(holder.shape(0)),
+                         holder.strides(0) / sizeof(double)};
+}
+
+
 const std::map<std::string, KernelType> KERNEL_MAP = {
     {"rbf", KernelType::RBF},
     {"polynomial", KernelType::Polynomial},
@@ -43,19 +96,56 @@ SVM::SVM(const Float C, const Float tol, const std::string &kernel_type,
   this->_svm = ado::core::SVM(C, tol, std::move(kernel), max_steps, seed);
 };
 
-void SVM::fit(xt::pyarray<double> &x, xt::pyarray<double> &y) {
-  return this->_svm.fit(x, y);
+void SVM::fit(const py::array &x, const py::array &y) {
+  py::array x_holder, y_holder;
+  const auto x_view = matrix_view(x, x_holder);
+  const auto y_view = vector_view(y, y_holder);
+
+  py::gil_scoped_release release;
+  std::unique_lock<std::shared_timed_mutex> lock(this->_mutex);
+  this->_svm.fit(x_view, y_view);
 }
 
-xt::pyarray<double> SVM::fit_predict(xt::pyarray<double> &x,
-                                     xt::pyarray<double> &y) {
-  return this->_svm.fit_predict(x, y);
+py::array_t<double> SVM::fit_predict(const py::array &x, const py::array &y) {
+  py::array x_holder, y_holder;
+  const auto x_view = matrix_view(x, x_holder);
+  const auto y_view = vector_view(y, y_holder);
+  py::array_t<double> y_hat(static_cast<py::ssize_t>(x_view.rows));
+  double *out = y_hat.mutable_data();
+
+  {
+    py::gil_scoped_release release;
+    std::unique_lock<std::shared_timed_mutex> lock(this->_mutex);
+    this->_svm.fit(x_view, y_view);
+    this->_svm.predict(x_view, out);
+  }
+  return y_hat;
 }
 
-xt::pyarray<double> SVM::predict(xt::pyarray<double> &x) {
-  return this->_svm.predict(x);
+py::array_t<double> SVM::predict(const py::array &x) {
+  py::array x_holder;
+  const auto x_view = matrix_view(x, x_holder);
+  py::array_t<double> y_hat(static_cast<py::ssize_t>(x_view.rows));
+  double *out = y_hat.mutable_data();
+
+  {
+    py::gil_scoped_release release;
+    std::shared_lock<std::shared_timed_mutex> lock(this->_mutex);
+    this->_svm.predict(x_view, out);
+  }
+  return y_hat;
 }
 
-xt::pyarray<double> SVM::decision_function(xt::pyarray<double> &x) {
-  return this->_svm.decision_function(x);
-}
\ No newline at end of file
+py::array_t<double> SVM::decision_function(const py::array &x) {
+  py::array x_holder;
+  const auto x_view = matrix_view(x, x_holder);
+  py::array_t<double> y_hat(static_cast<py::ssize_t>(x_view.rows));
+  double *out = y_hat.mutable_data();
+
+  {
+    py::gil_scoped_release release;
+    std::shared_lock<std::shared_timed_mutex> lock(this->_mutex);
+    this->_svm.decision_function(x_view, out);
+  }
+  return y_hat;
+}
@@ -2,28 +2,37 @@
 #define ADO_BINDINGS_PY_SVM
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
 
 #include "ado/core/svm.h"
-#include "xtensor-python/pyarray.hpp"
-#include "xtensor/xarray.hpp"
-#include "xtensor/xmath.hpp"
+#include "pybind11/numpy.h"
 
 using ado::Float;
 
+/**
+ * Python facing SVM. NumPy inputs are used in place when they are float64
+ * with contiguous rows (C-contiguous arrays and row slices), any other array
+ * (float32, Fortran order, ...) is converted once. The GIL is released while
+ * the model runs, _mutex then serializes the fits with any other call on the
+ * same object, while predictions may run concurrently.
+ */
 struct SVM {
   SVM(const Float C, const Float tol, const std::string &kernel_type,
       const std::size_t max_steps, const std::size_t seed, const Float gamma,
       const Float degree, const Float coeff);
 
-  void fit(xt::pyarray<double> &x, xt::pyarray<double> &y);
-  xt::pyarray<double> fit_predict(xt::pyarray<double> &x,
-                                  xt::pyarray<double> &y);
+  void fit(const pybind11::array &x, const pybind11::array &y);
+  pybind11::array_t<double> fit_predict(const pybind11::array &x,
+                                        const pybind11::array &y);
 
-  xt::pyarray<double> predict(xt::pyarray<double> &x);
-  xt::pyarray<double> decision_function(xt::pyarray<double> &x);
+  pybind11::array_t<double> predict(const pybind11::array &x);
+  pybind11::array_t<double> decision_function(const pybind11::array &x);
 
   ado::core::SVM _svm;
+  // Exclusive in fit and fit_predict, shared in predict and
+  // decision_function (std::shared_mutex requires C++17).
+  std::shared_timed_mutex _mutex;
 };
 
-#endif  // ADO_BINDINGS_PY_SVM
\ No newline at end of file
+#endif  // ADO_BINDINGS_PY_SVM
@@ -6,6 +6,7 @@
 
 #include "ado/core/kernel.h"
 #include "ado/core/svm.h"
+#include "ado/preprocessing/scaler.h"
 #include "ado/types.h"
 #include "ado/utils/io.h"
 #include "ado/utils/logger.h"
@@ -14,18 +15,13 @@ using ado::FloatArray;
 using ado::core::Kernel;
 using ado::core::KernelPolynomial;
 using ado::core::SVM;
+using ado::preprocessing::MinMaxScaler;
 using ado::utils::load_data;
 using ado::utils::LogFileHandler;
 using ado::utils::Logger;
 using ado::utils::LogLevel;
 using ado::utils::LogStreamHandler;
 
-FloatArray column_wise_normalization(const FloatArray& x) {
-  auto c_max = xt::amax(x, 0);
-  auto c_min = xt::amin(x, 0);
-  return xt::eval((x - c_min) / (c_max - c_min));
-}
-
 void target_preprocessing(FloatArray& y) {
   filtration(y, xt::equal(y, 0)) = -1;
 }
@@ -59,7 +55,10 @@ int main(int argc, char* argv[]) {
   FloatArray y_train =
       xt::view(training_data, xt::range(0, n_train_samples), 5);
 
-  x_train = column_wise_normalization(x_train);
+  // Fit the scaler on the training data only, and reuse it on the test data.
+  MinMaxScaler scaler;
+  scaler.fit(x_train);
+  scaler.transform_inplace(x_train);
   target_preprocessing(y_train);
 
   // Load and shuffle the testing data.
@@ -71,7 +70,7 @@ int main(int argc, char* argv[]) {
       xt::view(test_data, xt::range(0, n_test_samples), xt::range(0, 5));
   FloatArray y_test = xt::view(test_data, xt::range(0, n_test_samples), 5);
 
-  x_test = column_wise_normalization(x_test);
+  scaler.transform_inplace(x_test);
   target_preprocessing(y_test);
 
   // Define a linear kernel.
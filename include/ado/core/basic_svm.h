@@ -0,0 +1,333 @@
+#ifndef ADO_CORE_BASIC_SVM_H
+#define ADO_CORE_BASIC_SVM_H
+
+#include <chrono>
+#include <random>
+
+#include "ado/core/kernel_functions.h"
+#include "ado/core/model.h"
+#include "ado/core/packed_support.h"
+#include "ado/types.h"
+#include "ado/utils/row_source.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Limits of an anytime training, 0 means unlimited.
+ *
+ * SMO only moves between feasible solutions (0 <= alpha_i <= C and
+ * sum(alpha_i y_i) = 0), so when a limit is reached the fit stops and keeps
+ * the current solution, which is usable but not converged.
+ */
+struct TrainingBudget {
+  // Wall-clock time of a fit, including the kernel matrix precomputation.
+  std::chrono::milliseconds time_limit = std::chrono::milliseconds(0);
+  // Kernel evaluations of a fit, including the kernel matrix precomputation.
+  std::size_t max_kernel_evaluations = 0;
+};
+
+/**
+ * @brief Kernel independent state of the BasicSVM models.
+ *
+ * Holds the hyper-parameters and the fitted support vectors, so that the
+ * fitted state can be inspected without knowing the kernel type.
+ */
+class SVMBase : public Model {
+ public:
+  /**
+   * @brief Construct a new SVMBase object
+   *
+   * @param C strictly positive regularization parameter.
+   * @param tol tolerance for stopping criteria.
+   * @param max_steps maximum number of iteration of the SMO algorithm.
+   * @param seed used for the generation of pseudo random numbers and shuffling.
+   */
+  SVMBase(const Float C, const Float tol, const std::size_t max_steps,
+          const std::size_t seed);
+
+  SVMBase() = default;
+
+  using Model::decision_function;
+  using Model::fit;
+  using Model::predict;
+
+  /**
+   * @brief Fit the model on borrowed data, without copying it.
+   *
+   * @param x view over the training data, with shape (N,M).
+   * @param y view over the target labels, with shape (N) and binary values
+   * [-1, 1].
+   */
+  virtual void fit(const MatrixView& x, const VectorView& y) = 0;
+
+  /**
+   * @brief Fit the model out-of-core.
+   *
+   * The rows are read from the source on demand and the hot ones are kept in
+   * a utils::RowCache, so the memory used for the training data is bounded by
+   * memory_budget instead of the dataset size.
+   *
+   * @param x source of the training data, with shape (N,M).
+   * @param y view over the target labels, with shape (N) and binary values
+   * [-1, 1].
+   * @param memory_budget maximum number of bytes used to cache the rows.
+   */
+  virtual void fit(const utils::RowSource& x, const VectorView& y,
+                   const std::size_t memory_budget) = 0;
+
+  /**
+   * @brief Run inference on borrowed data and write the un-thresholded
+   * predicted values to a caller-provided buffer.
+   *
+   * @param x view over the input data, with shape (N,M).
+   * @param out buffer of N values receiving the predictions.
+   */
+  virtual void decision_function(const MatrixView& x, Float* out) const = 0;
+
+  /**
+   * @brief Run inference on borrowed data and write the predicted labels to a
+   * caller-provided buffer.
+   *
+   * @param x view over the input data, with shape (N,M).
+   * @param out buffer of N values receiving the labels [-1, 1].
+   */
+  void predict(const MatrixView& x, Float* out) const;
+
+  FloatArray fit_predict(const FloatArray& x, const FloatArray& y) override;
+  FloatArray predict(const FloatArray& x) const override;
+
+  /**
+   * @brief Support vectors of shape (S,M), unpacked from the inference layout
+   * they are stored in.
+   */
+  inline FloatArray support_vectors() const { return this->_packed.unpack(); }
+  inline std::size_t n_features() const { return this->_packed.n_features(); }
+  inline const FloatArray& support_labels() const { return this->_y_support; }
+  inline const FloatArray& alphas() const { return this->_alphas; }
+
+  /**
+   * @brief Indexes of the support vectors in the training data, empty if the
+   * support set was replaced with set_support.
+   */
+  inline const SizeArray& support_indices() const {
+    return this->_support_indices;
+  }
+
+  /**
+   * @brief Bias term, the decision function is sum(alpha_i y_i K_i) - b.
+   */
+  inline Float bias() const { return this->_b; }
+
+  /**
+   * @brief Limit the time and the kernel evaluations of the next fits.
+   */
+  inline void set_budget(const TrainingBudget& budget) {
+    this->_budget = budget;
+  }
+  inline const TrainingBudget& budget() const { return this->_budget; }
+
+  /**
+   * @brief Largest kernel matrix, in bytes, precomputed by the in-memory
+   * fits. Larger training sets evaluate the kernel on demand, 0 disables the
+   * precomputation.
+   */
+  inline void set_gram_budget(const std::size_t bytes) {
+    this->_gram_budget = bytes;
+  }
+  inline std::size_t gram_budget() const { return this->_gram_budget; }
+
+  /**
+   * @brief Threads computing the kernel matrix, 0 for the hardware
+   * concurrency.
+   */
+  inline void set_gram_threads(const std::size_t n_threads) {
+    this->_gram_threads = n_threads;
+  }
+  inline std::size_t gram_threads() const { return this->_gram_threads; }
+
+  /**
+   * @brief Whether the last fit was stopped by the budget before converging.
+   */
+  inline bool stopped_early() const { return this->_stopped_early; }
+
+  /**
+   * @brief Number of kernel evaluations of the last fit.
+   */
+  inline std::size_t kernel_evaluations() const {
+    return this->_kernel_evaluations;
+  }
+
+  /**
+   * @brief Number of successful SMO steps (joint alpha updates) of the last
+   * fit.
+   */
+  inline std::size_t iterations() const { return this->_iterations; }
+
+  /**
+   * @brief Replace the fitted support vectors (e.g. after a compression).
+   *
+   * @param x_support array of shape (S,M) containing the support vectors.
+   * @param y_support array of shape (S) containing their labels.
+   * @param alphas array of shape (S) containing their multipliers.
+   * @param b bias term.
+   */
+  void set_support(FloatArray x_support, FloatArray y_support,
+                   FloatArray alphas, const Float b);
+
+ protected:
+  /**
+   * @brief Compute the bias term.
+   */
+  Float compute_b(const Float& e1, const Float& e2, const Float& y1,
+                  const Float& a1, const Float& alph1, const Float& y2,
+                  const Float& a2, const Float& alph2, const Float& k11,
+                  const Float& k12, const Float& k22) const;
+  /**
+   * @brief Compute the gamma term.
+   */
+  Float compute_gamma(const Float& alph1, const Float& alph2, const Float& V,
+                      const Float& k11, const Float& k12, const Float& k22,
+                      const Float& s, const Float& y1, const Float& y2,
+                      const Float& e1, const Float& e2) const;
+
+  /**
+   * @brief Start counting the budget of a fit.
+   */
+  void start_budget();
+
+  /**
+   * @brief Check the budget, cheap enough to be called before every SMO step.
+   */
+  bool budget_exhausted();
+
+  /**
+   * @brief Store the support vectors in the packed inference layout, with
+   * the coefficients of the current alphas and labels.
+   */
+  void pack_support(const FloatArray& x_support);
+
+  Float _C = 1.0;
+  Float _tol = 1e-3;
+  FloatArray _alphas = FloatArray();
+  Float _b = 0.0;
+  FloatArray _errors = FloatArray();
+  FloatArray _y_support = FloatArray();
+  SizeArray _support_indices = SizeArray();
+  PackedSupport _packed = PackedSupport();
+  std::size_t _max_steps = 1e3;
+  std::size_t _seed = 16;
+  // Per model engine, so that models can be trained concurrently.
+  std::mt19937 _engine = std::mt19937(16);
+
+  TrainingBudget _budget = TrainingBudget();
+  std::chrono::steady_clock::time_point _deadline;
+  std::size_t _kernel_evaluations = 0;
+  bool _stopped_early = false;
+  std::size_t _iterations = 0;
+  std::size_t _gram_budget = std::size_t(1) << 30;
+  std::size_t _gram_threads = 0;
+};
+
+/**
+ * @brief Support Vector Machine (SVM) model specialized on the kernel type.
+ *
+ * Same SMO solver as SVM, with the kernel known at compile time: every kernel
+ * value in the hot path is an inlined function of two raw rows instead of a
+ * virtual call returning a temporary array. Instantiated for
+ * kernels::Polynomial, kernels::RBF and kernels::Sigmoid.
+ *
+ * @tparam KernelT kernel value type (see kernel_functions.h).
+ */
+template <typename KernelT>
+class BasicSVM : public SVMBase {
+ public:
+  /**
+   * @brief Construct a new BasicSVM object
+   *
+   * @param C strictly positive regularization parameter.
+   * @param tol tolerance for stopping criteria.
+   * @param kernel kernel value.
+   * @param max_steps maximum number of iteration of the SMO algorithm.
+   * @param seed used for the generation of pseudo random numbers and shuffling.
+   */
+  BasicSVM(const Float C, const Float tol, const KernelT& kernel,
+           const std::size_t max_steps, const std::size_t seed);
+
+  BasicSVM() = default;
+
+  /**
+   * @brief Fit the model.
+   *
+   * @param x multi-dimensional array containing the training data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @param y array containing the target labels. The array must have shape
+   * (N,1) or (N) and binary values [-1, 1]. With N number of samples.
+   */
+  void fit(const FloatArray& x, const FloatArray& y) override;
+  void fit(const MatrixView& x, const VectorView& y) override;
+  void fit(const utils::RowSource& x, const VectorView& y,
+           const std::size_t memory_budget) override;
+
+  /**
+   * @brief Run inference and return the un-thresholded predicted values.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the un-thresholded predicted values.
+   * The array has shape (N) and real values. With N number of samples.
+   */
+  FloatArray decision_function(const FloatArray& x) const override;
+  void decision_function(const MatrixView& x, Float* out) const override;
+
+  inline const KernelT& kernel() const { return this->_kernel; }
+
+ private:
+  /**
+   * @brief Run the SMO algorithm, within the budget started by the caller.
+   *
+   * @tparam EvaluatorT callable returning K(x_i, x_j) for two sample indexes,
+   * counting the kernel evaluations it does.
+   */
+  template <typename EvaluatorT>
+  void smo(const EvaluatorT& k, const VectorView& y,
+           const std::size_t n_samples);
+
+  /**
+   * @brief Keep the samples with a non-zero alpha as support vectors.
+   *
+   * @tparam CopyRowT callable copying the features of a sample to a buffer.
+   */
+  template <typename CopyRowT>
+  void store_support(const VectorView& y, const std::size_t n_features,
+                     const CopyRowT& copy_row);
+
+  /**
+   * @brief Evaluate the model on the training sample i.
+   */
+  template <typename EvaluatorT>
+  Float eval(const EvaluatorT& k, const VectorView& y,
+             const std::size_t i) const;
+
+  /**
+   * @brief Examine example step of the SMO algorithm.
+   */
+  template <typename EvaluatorT>
+  std::int8_t examine_example(const EvaluatorT& k, const std::size_t i2,
+                              const VectorView& y);
+
+  /**
+   * @brief Take step of the SMO algorithm.
+   */
+  template <typename EvaluatorT>
+  std::int8_t take_step(const EvaluatorT& k, const std::size_t i1,
+                        const std::size_t i2, const VectorView& y,
+                        const Float& y2, const Float& alph2, const Float& e2);
+
+  KernelT _kernel = KernelT();
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_BASIC_SVM_H
@@ -0,0 +1,112 @@
+#ifndef ADO_CORE_CASCADE_SVM_H
+#define ADO_CORE_CASCADE_SVM_H
+
+#include <memory>
+#include <vector>
+
+#include "ado/core/kernel.h"
+#include "ado/core/model.h"
+#include "ado/core/svm.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Cascade Support Vector Machine (SVM) model.
+ *
+ * Partitioned SVM training, based on:
+ * Graf, Hans P., et al. "Parallel support vector machines: The cascade SVM."
+ * (2005).
+ *
+ * The training data is split in P partitions trained in parallel, then the
+ * support vectors of pairs of models are merged and re-trained layer by layer
+ * until a single model is left. If some training sample violates the KKT
+ * conditions of that model, its support vectors are fed back to every
+ * partition and the cascade runs again.
+ *
+ * The workers exchange support vector sets as indexes into the training data,
+ * either in memory (threads) or through pipes (forked local processes).
+ * Workers::Processes must be used from a single-threaded caller: a forked
+ * worker only has the forking thread, and would deadlock on any lock (e.g.
+ * of the tracer) held by another thread of the parent at the time of the
+ * fork. The logger is disabled in the workers for that reason.
+ */
+class CascadeSVM : public Model {
+ public:
+  enum class Workers { Threads = 0, Processes = 1 };
+
+  /**
+   * @brief Construct a new CascadeSVM object
+   *
+   * @param C strictly positive regularization parameter.
+   * @param tol tolerance for stopping criteria and KKT conditions.
+   * @param kernel kernel object (e.g. linear or rbf).
+   * @param max_steps maximum number of iteration of the SMO algorithm.
+   * @param seed used for the partitioning and the SMO algorithm.
+   * @param n_partitions number of partitions of the first layer.
+   * @param workers run the partitions on threads or local processes.
+   * @param max_passes maximum number of passes through the cascade.
+   */
+  CascadeSVM(const Float C, const Float tol, std::unique_ptr<Kernel> kernel,
+             const std::size_t max_steps, const std::size_t seed,
+             const std::size_t n_partitions, const Workers workers,
+             const std::size_t max_passes);
+
+  void fit(const FloatArray& x, const FloatArray& y) override;
+  FloatArray fit_predict(const FloatArray& x, const FloatArray& y) override;
+  FloatArray predict(const FloatArray& x) const override;
+  FloatArray decision_function(const FloatArray& x) const override;
+
+  /**
+   * @brief Final model of the cascade.
+   */
+  inline const SVM& model() const { return this->_model; }
+
+  /**
+   * @brief Whether the last fit satisfied the KKT conditions on all samples.
+   */
+  inline bool converged() const { return this->_converged; }
+
+ private:
+  using IndexSet = std::vector<std::size_t>;
+
+  /**
+   * @brief Train a model on a subset of the data, return the global indexes
+   * of its support vectors.
+   *
+   * @param n_workers number of models of the layer trained concurrently.
+   */
+  IndexSet train(const FloatArray& x, const FloatArray& y,
+                 const IndexSet& subset, const std::size_t n_workers) const;
+
+  /**
+   * @brief Train every subset of a layer concurrently.
+   */
+  std::vector<IndexSet> run_layer(const FloatArray& x, const FloatArray& y,
+                                  const std::vector<IndexSet>& subsets) const;
+  std::vector<IndexSet> run_threads(const FloatArray& x, const FloatArray& y,
+                                    const std::vector<IndexSet>& subsets) const;
+  std::vector<IndexSet> run_processes(
+      const FloatArray& x, const FloatArray& y,
+      const std::vector<IndexSet>& subsets) const;
+
+  SVM make_svm() const;
+
+  Float _C = 1.0;
+  Float _tol = 1e-3;
+  std::unique_ptr<Kernel> _kernel;
+  std::size_t _max_steps = 1e3;
+  std::size_t _seed = 16;
+  std::size_t _n_partitions = 2;
+  Workers _workers = Workers::Threads;
+  std::size_t _max_passes = 3;
+
+  SVM _model = SVM();
+  bool _converged = false;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_CASCADE_SVM_H
@@ -0,0 +1,35 @@
+#ifndef ADO_CORE_CPP_EXPORT_H
+#define ADO_CORE_CPP_EXPORT_H
+
+#include <string>
+
+#include "ado/core/svm.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Export a fitted SVM as a self-contained C++ header.
+ *
+ * The generated header only depends on <cmath> and <cstddef> and compiles as
+ * C++14. In namespace `name` it defines the bias and the dimensions as
+ * constants, and the inline functions `double decision_function(const
+ * double* x)` and `double predict(const double* x)` for a sample of kFeatures
+ * values. The support vectors and the coefficients alpha_i y_i are static
+ * constexpr alignas(64) arrays local to decision_function, so the header can
+ * be included in several translation units without violating the ODR. The
+ * kernel is specialized on its parameters and on the number of features, with
+ * the loop over the features fully unrolled, so inference does not allocate.
+ * The values are written with max_digits10 digits and round-trip exactly.
+ *
+ * @param svm fitted SVM model.
+ * @param filepath path of the header to write.
+ * @param name C++ identifier used for the namespace and the include guard.
+ */
+void export_cpp_header(const SVM& svm, const std::string& filepath,
+                       const std::string& name);
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_CPP_EXPORT_H
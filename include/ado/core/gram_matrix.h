@@ -0,0 +1,76 @@
+#ifndef ADO_CORE_GRAM_MATRIX_H
+#define ADO_CORE_GRAM_MATRIX_H
+
+#include <chrono>
+#include <memory>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Precomputed kernel matrix K(x_i, x_j) of a training set.
+ *
+ * Only the lower triangle is stored, row by row, since K is symmetric, and
+ * every value is computed once, with the kernel operator() used by the
+ * solver. The pairs are visited by blocks of kBlockRows x kBlockRows, so that
+ * the two blocks of rows are reused from cache when they fit in it (there is
+ * no blocking over the features), and the rows of blocks are distributed
+ * over threads.
+ * The computation stops at an optional deadline, leaving the matrix
+ * incomplete.
+ */
+class GramMatrix {
+ public:
+  static constexpr std::size_t kBlockRows = 64;
+
+  /**
+   * @brief Bytes needed by the matrix of n_samples samples.
+   */
+  static std::size_t bytes(const std::size_t n_samples);
+
+  /**
+   * @brief Construct a new GramMatrix object
+   *
+   * @tparam KernelT kernel value type (see kernel_functions.h).
+   * @param x training data of shape (N,M).
+   * @param n_threads threads computing the matrix, 0 for the hardware
+   * concurrency.
+   * @param deadline time after which no row of blocks is started.
+   */
+  template <typename KernelT>
+  GramMatrix(const KernelT& kernel, const MatrixView& x,
+             const std::size_t n_threads = 0,
+             const std::chrono::steady_clock::time_point deadline =
+                 std::chrono::steady_clock::time_point::max());
+
+  inline Float operator()(const std::size_t i, const std::size_t j) const {
+    return (i >= j) ? this->_values[i * (i + 1) / 2 + j]
+                    : this->_values[j * (j + 1) / 2 + i];
+  }
+
+  inline std::size_t size() const { return this->_n_samples; }
+
+  /**
+   * @brief Kernel evaluations done by the constructor.
+   */
+  inline std::size_t evaluations() const { return this->_evaluations; }
+
+  /**
+   * @brief Whether every value was computed before the deadline.
+   */
+  inline bool complete() const {
+    return this->_evaluations == this->_n_samples * (this->_n_samples + 1) / 2;
+  }
+
+ private:
+  std::size_t _n_samples = 0;
+  std::size_t _evaluations = 0;
+  std::unique_ptr<Float[]> _values;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_GRAM_MATRIX_H
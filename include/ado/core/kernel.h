@@ -1,6 +1,8 @@
 #ifndef ADO_CORE_KERNEL_H
 #define ADO_CORE_KERNEL_H
 
+#include <memory>
+
 #include "ado/types.h"
 
 namespace ado {
@@ -15,6 +17,23 @@ class Kernel {
   Kernel(const KernelType type) : _type(type){};
   virtual FloatArray operator()(const FloatArray& x1,
                                 const FloatArray& x2) const = 0;
+
+  /**
+   * @brief Compute the Gram matrix between two sets of samples. By default
+   * one row at a time with operator().
+   *
+   * @param x1 array of shape (N1,M).
+   * @param x2 array of shape (N2,M).
+   * @return FloatArray array of shape (N1,N2) with K(x1_i, x2_j) in (i,j).
+   */
+  virtual FloatArray gram(const FloatArray& x1, const FloatArray& x2) const;
+
+  /**
+   * @brief Copy of the kernel, with the same type and parameters. Throws
+   * std::invalid_argument unless overridden.
+   */
+  virtual std::unique_ptr<Kernel> clone() const;
+
   inline KernelType type() const { return this->_type; }
 
  private:
@@ -27,6 +46,13 @@ class KernelPolynomial : public Kernel {
                             const Float coeff);
   virtual FloatArray operator()(const FloatArray& x1,
                                 const FloatArray& x2) const override;
+  virtual FloatArray gram(const FloatArray& x1,
+                          const FloatArray& x2) const override;
+  virtual std::unique_ptr<Kernel> clone() const override;
+
+  inline Float degree() const { return this->_degree; }
+  inline Float gamma() const { return this->_gamma; }
+  inline Float coeff() const { return this->_coeff; }
 
  private:
   Float _degree = 1.0;
@@ -39,6 +65,11 @@ class KernelRBF : public Kernel {
   explicit KernelRBF(const Float gamma);
   virtual FloatArray operator()(const FloatArray& x1,
                                 const FloatArray& x2) const override;
+  virtual FloatArray gram(const FloatArray& x1,
+                          const FloatArray& x2) const override;
+  virtual std::unique_ptr<Kernel> clone() const override;
+
+  inline Float gamma() const { return this->_gamma; }
 
  private:
   Float _gamma = 1.0;
@@ -49,12 +80,37 @@ class KernelSigmoid : public Kernel {
   explicit KernelSigmoid(const Float gamma, const Float coeff);
   virtual FloatArray operator()(const FloatArray& x1,
                                 const FloatArray& x2) const override;
+  virtual FloatArray gram(const FloatArray& x1,
+                          const FloatArray& x2) const override;
+  virtual std::unique_ptr<Kernel> clone() const override;
+
+  inline Float gamma() const { return this->_gamma; }
+  inline Float coeff() const { return this->_coeff; }
 
  private:
   Float _gamma = 1.0;
   Float _coeff = 0.0;
 };
 
+/**
+ * @brief Type and parameters of one of the kernels above.
+ */
+struct KernelParameters {
+  KernelType type = KernelType::RBF;
+  Float degree = 1.0;
+  Float gamma = 1.0;
+  Float coeff = 0.0;
+};
+
+/**
+ * @brief Parameters of a KernelPolynomial, KernelRBF or KernelSigmoid,
+ * identified by their dynamic type.
+ *
+ * The specialized models, exports and serialization only support these
+ * kernels, any other Kernel subclass is rejected with std::invalid_argument.
+ */
+KernelParameters kernel_parameters(const Kernel& kernel);
+
 }  // namespace core
 }  // namespace ado
 
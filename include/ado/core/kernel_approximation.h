@@ -0,0 +1,112 @@
+#ifndef ADO_CORE_KERNEL_APPROXIMATION_H
+#define ADO_CORE_KERNEL_APPROXIMATION_H
+
+#include <memory>
+
+#include "ado/core/kernel.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Explicit feature map approximating a kernel.
+ *
+ * A kernel approximation maps each sample x to a low-dimensional embedding
+ * z(x) such that z(x1).z(x2) ~ K(x1, x2). A linear model trained on the
+ * embedding approximates the corresponding kernel model, while training and
+ * inference cost grow with the embedding size instead of with the number of
+ * support vectors.
+ */
+class KernelApproximation {
+ public:
+  virtual ~KernelApproximation() = default;
+
+  /**
+   * @brief Fit the feature map.
+   *
+   * @param x multi-dimensional array containing the training data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   */
+  virtual void fit(const FloatArray& x) = 0;
+
+  /**
+   * @brief Map the input data to the approximated feature space.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array of shape (N,D), with D number of components.
+   */
+  virtual FloatArray transform(const FloatArray& x) const = 0;
+
+  /**
+   * @brief Fit the feature map and transform the input data.
+   */
+  FloatArray fit_transform(const FloatArray& x);
+};
+
+/**
+ * @brief Nystroem kernel approximation.
+ *
+ * Approximates any kernel from a random subset of the training samples
+ * (landmarks), see:
+ * Williams, Christopher, and Matthias Seeger. "Using the Nystroem method to
+ * speed up kernel machines." (2001).
+ */
+class Nystroem : public KernelApproximation {
+ public:
+  /**
+   * @brief Construct a new Nystroem object
+   *
+   * @param kernel kernel object to approximate.
+   * @param n_components number of landmarks, i.e. size of the embedding.
+   * @param seed used for the selection of the landmarks.
+   */
+  Nystroem(std::unique_ptr<Kernel> kernel, const std::size_t n_components,
+           const std::size_t seed);
+
+  void fit(const FloatArray& x) override;
+  FloatArray transform(const FloatArray& x) const override;
+
+ private:
+  std::unique_ptr<Kernel> _kernel;
+  std::size_t _n_components = 100;
+  std::size_t _seed = 16;
+  FloatArray _landmarks = FloatArray();
+  FloatArray _normalization = FloatArray();
+};
+
+/**
+ * @brief Random Fourier features approximating the RBF kernel.
+ *
+ * Implementation of:
+ * Rahimi, Ali, and Benjamin Recht. "Random features for large-scale kernel
+ * machines." (2007).
+ */
+class RandomFourierFeatures : public KernelApproximation {
+ public:
+  /**
+   * @brief Construct a new RandomFourierFeatures object
+   *
+   * @param gamma gamma parameter of the approximated RBF kernel.
+   * @param n_components number of random features, i.e. size of the embedding.
+   * @param seed used for the generation of the random projections.
+   */
+  RandomFourierFeatures(const Float gamma, const std::size_t n_components,
+                        const std::size_t seed);
+
+  void fit(const FloatArray& x) override;
+  FloatArray transform(const FloatArray& x) const override;
+
+ private:
+  Float _gamma = 1.0;
+  std::size_t _n_components = 100;
+  std::size_t _seed = 16;
+  FloatArray _weights = FloatArray();
+  FloatArray _offsets = FloatArray();
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_KERNEL_APPROXIMATION_H
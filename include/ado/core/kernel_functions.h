@@ -0,0 +1,115 @@
+#ifndef ADO_CORE_KERNEL_FUNCTIONS_H
+#define ADO_CORE_KERNEL_FUNCTIONS_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * Kernel value types used by BasicSVM.
+ *
+ * Unlike the Kernel class hierarchy, these are plain structs evaluated on raw
+ * contiguous rows: the scalar operator() and the row-block evaluation are
+ * inlined in the solver, without virtual calls or temporary arrays.
+ */
+namespace kernels {
+
+inline Float dot(const Float* x1, const Float* x2, const std::size_t n) {
+  Float s = 0.0;
+  for (std::size_t k = 0; k < n; ++k) s += x1[k] * x2[k];
+  return s;
+}
+
+inline Float squared_distance(const Float* x1, const Float* x2,
+                              const std::size_t n) {
+  Float s = 0.0;
+  for (std::size_t k = 0; k < n; ++k) {
+    const Float d = x1[k] - x2[k];
+    s += d * d;
+  }
+  return s;
+}
+
+struct Polynomial {
+  Float degree = 1.0;
+  Float gamma = 1.0;
+  Float coeff = 0.0;
+
+  inline Float operator()(const Float* x1, const Float* x2,
+                          const std::size_t n) const {
+    return std::pow(this->gamma * dot(x1, x2, n) + this->coeff, this->degree);
+  }
+
+  /**
+   * @brief K(x1, x2) from the dot product x1.x2.
+   */
+  inline Float from_dot(const Float dot12) const {
+    return std::pow(this->gamma * dot12 + this->coeff, this->degree);
+  }
+
+  /**
+   * @brief Evaluate K(x, rows_i) for n_rows contiguous rows of n features.
+   */
+  inline void block(const Float* x, const Float* rows, const std::size_t n_rows,
+                    const std::size_t n, Float* out) const {
+    for (std::size_t i = 0; i < n_rows; ++i) {
+      out[i] = (*this)(x, rows + i * n, n);
+    }
+  }
+};
+
+struct RBF {
+  Float gamma = 1.0;
+
+  inline Float operator()(const Float* x1, const Float* x2,
+                          const std::size_t n) const {
+    return this->from_squared_distance(squared_distance(x1, x2, n));
+  }
+
+  /**
+   * @brief K(x1, x2) from the squared distance |x1 - x2|^2, computed exactly
+   * rather than from |x1|^2 + |x2|^2 - 2 x1.x2, which cancels for close
+   * points far from the origin.
+   */
+  inline Float from_squared_distance(const Float distance2) const {
+    return std::exp(-this->gamma * distance2);
+  }
+
+  inline void block(const Float* x, const Float* rows, const std::size_t n_rows,
+                    const std::size_t n, Float* out) const {
+    for (std::size_t i = 0; i < n_rows; ++i) {
+      out[i] = (*this)(x, rows + i * n, n);
+    }
+  }
+};
+
+struct Sigmoid {
+  Float gamma = 1.0;
+  Float coeff = 0.0;
+
+  inline Float operator()(const Float* x1, const Float* x2,
+                          const std::size_t n) const {
+    return std::tanh(this->gamma * dot(x1, x2, n) + this->coeff);
+  }
+
+  inline Float from_dot(const Float dot12) const {
+    return std::tanh(this->gamma * dot12 + this->coeff);
+  }
+
+  inline void block(const Float* x, const Float* rows, const std::size_t n_rows,
+                    const std::size_t n, Float* out) const {
+    for (std::size_t i = 0; i < n_rows; ++i) {
+      out[i] = (*this)(x, rows + i * n, n);
+    }
+  }
+};
+
+}  // namespace kernels
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_KERNEL_FUNCTIONS_H
@@ -0,0 +1,86 @@
+#ifndef ADO_CORE_LINEAR_SVM_H
+#define ADO_CORE_LINEAR_SVM_H
+
+#include "ado/core/model.h"
+#include "ado/types.h"
+#include "ado/utils/mapped_matrix.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Linear Support Vector Machine (SVM) model.
+ *
+ * Implementation of a binary linear SVM (L1-loss) trained with the dual
+ * coordinate descent method used by LIBLINEAR:
+ * Hsieh, Cho-Jui, et al. "A dual coordinate descent method for large-scale
+ * linear SVM." (2008).
+ * https://www.csie.ntu.edu.tw/~cjlin/papers/cddual.pdf
+ *
+ * Unlike SVM, the weight vector is kept explicitly, so every coordinate update
+ * costs O(M) and inference is a single dot product per sample. Samples are
+ * visited in a random permutation at every pass and bounded variables that
+ * are unlikely to change are shrunk from the active set.
+ */
+class LinearSVM : public Model {
+ public:
+  /**
+   * @brief Construct a new LinearSVM object
+   *
+   * @param C strictly positive regularization parameter.
+   * @param tol tolerance on the projected gradient for the stopping criteria.
+   * @param max_steps maximum number of passes over the active samples.
+   * @param seed used for the generation of the random permutations.
+   */
+  LinearSVM(const Float C, const Float tol, const std::size_t max_steps,
+            const std::size_t seed);
+
+  LinearSVM() = default;
+
+  /**
+   * @brief Fit the model.
+   *
+   * @param x multi-dimensional array containing the training data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @param y array containing the target labels. The array must have shape
+   * (N,1) or (N) and binary values [-1, 1]. With N number of samples.
+   */
+  void fit(const FloatArray& x, const FloatArray& y) override;
+
+  /**
+   * @brief Fit the model on a memory-mapped dataset.
+   *
+   * @param x memory-mapped matrix containing the training data, with shape
+   * (N,M), with N number of samples, and M number of features.
+   * @param y array containing the target labels. The array must have shape
+   * (N,1) or (N) and binary values [-1, 1]. With N number of samples.
+   */
+  void fit(const utils::MappedMatrix& x, const FloatArray& y);
+
+  FloatArray fit_predict(const FloatArray& x, const FloatArray& y) override;
+  FloatArray predict(const FloatArray& x) const override;
+  FloatArray decision_function(const FloatArray& x) const override;
+
+  /**
+   * @brief Weight vector of shape (M).
+   */
+  inline const FloatArray& weights() const { return this->_weights; }
+
+  /**
+   * @brief Bias term, the decision function is w.x + b.
+   */
+  inline Float bias() const { return this->_b; }
+
+ private:
+  Float _C = 1.0;
+  Float _tol = 1e-3;
+  std::size_t _max_steps = 1e3;
+  std::size_t _seed = 16;
+  FloatArray _weights = FloatArray();
+  Float _b = 0.0;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_LINEAR_SVM_H
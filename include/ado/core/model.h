@@ -12,8 +12,8 @@ class Model {
 
   virtual void fit(const FloatArray& x, const FloatArray& y) = 0;
   virtual FloatArray fit_predict(const FloatArray& x, const FloatArray& y) = 0;
-  virtual FloatArray predict(const FloatArray& x) = 0;
-  virtual FloatArray decision_function(const FloatArray& x) = 0;
+  virtual FloatArray predict(const FloatArray& x) const = 0;
+  virtual FloatArray decision_function(const FloatArray& x) const = 0;
 };
 
 }  // namespace core
@@ -0,0 +1,99 @@
+#ifndef ADO_CORE_MODEL_REGISTRY_H
+#define ADO_CORE_MODEL_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ado/core/model.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Named fitted models, replaceable while other threads run inference.
+ *
+ * The registry content is an immutable snapshot, swapped RCU style: a writer
+ * copies the current snapshot, applies its change, publishes the copy with an
+ * atomic pointer exchange and then waits for the readers of the old snapshot
+ * to leave before deleting it. Readers never take a lock, they register in
+ * one of two counters selected by the parity of the current epoch, and a
+ * writer advances the epoch and waits for the counter of the previous one to
+ * drain.
+ *
+ * Models are shared with std::shared_ptr<const Model>: a model replaced while
+ * a reader is still scoring with it is released when that reader drops its
+ * pointer. Published models must not be modified, Model::predict and
+ * Model::decision_function are const and safe to call concurrently.
+ */
+class ModelRegistry {
+ public:
+  using ModelPtr = std::shared_ptr<const Model>;
+
+  ModelRegistry();
+  ~ModelRegistry();
+
+  ModelRegistry(const ModelRegistry&) = delete;
+  ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+  /**
+   * @brief Publish a fitted model, replacing the model with the same name.
+   *
+   * @param name name of the model.
+   * @param model fitted model, must not be modified after publication.
+   */
+  void publish(const std::string& name, ModelPtr model);
+
+  /**
+   * @brief Remove a model from the registry.
+   *
+   * @return bool whether a model with that name was published.
+   */
+  bool remove(const std::string& name);
+
+  /**
+   * @brief Current model with the given name, nullptr if there is none. Never
+   * blocks.
+   */
+  ModelPtr get(const std::string& name) const;
+
+  /**
+   * @brief Number of changes applied to the registry.
+   */
+  std::uint64_t version() const;
+
+ private:
+  // Padded to a cache line, every reader writes to one of the counters.
+  struct alignas(64) Counter {
+    std::atomic<std::size_t> value{0};
+  };
+
+  struct Snapshot {
+    std::unordered_map<std::string, ModelPtr> models;
+    std::uint64_t version = 0;
+  };
+
+  /**
+   * @brief Read-side critical section, returns the counter to release.
+   */
+  std::atomic<std::size_t>& enter() const;
+
+  /**
+   * @brief Replace the current snapshot and reclaim the old one once its
+   * readers are gone. Must be called with the writer mutex held.
+   */
+  void replace(Snapshot* snapshot);
+
+  std::atomic<Snapshot*> _current{nullptr};
+  std::atomic<std::uint64_t> _epoch{0};
+  mutable Counter _readers[2];
+  std::mutex _writer;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_MODEL_REGISTRY_H
@@ -0,0 +1,121 @@
+#ifndef ADO_CORE_PACKED_SUPPORT_H
+#define ADO_CORE_PACKED_SUPPORT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "ado/core/kernel_functions.h"
+#include "ado/types.h"
+#include "ado/utils/aligned_allocator.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Support vectors packed for inference.
+ *
+ * This is the only copy of the support vectors held by the SVM models. They
+ * are stored in blocks of kBlockSize vectors, and inside a block
+ * feature-major (AoSoA): the kBlockSize values of feature f are contiguous,
+ * so a query is multiplied against a whole block with unit-stride
+ * vectorizable loops, and a block of a few KB stays in L1 while it is used.
+ * The buffers are 64-byte aligned and padded to whole blocks, the padding
+ * vectors have a zero coefficient. The coefficients alpha_i y_i are
+ * precomputed. The kernel values are obtained from the dot products of a
+ * block, or from its exact squared distances for RBF.
+ */
+class PackedSupport {
+ public:
+  static constexpr std::size_t kBlockSize = 8;
+
+  PackedSupport() = default;
+
+  /**
+   * @brief Construct a new PackedSupport object
+   *
+   * @param x_support array of shape (S,M) containing the support vectors.
+   * @param coefficients array of shape (S) containing alpha_i y_i.
+   */
+  PackedSupport(const FloatArray& x_support, const FloatArray& coefficients);
+
+  inline std::size_t n_support() const { return this->_n_support; }
+  inline std::size_t n_features() const { return this->_n_features; }
+  inline std::size_t n_blocks() const { return this->_n_blocks; }
+
+  /**
+   * @brief Support vectors of shape (S,M), in their original order.
+   */
+  FloatArray unpack() const;
+
+  /**
+   * @brief sum_i coefficient_i K(sv_i, x) for a query of n_features() values.
+   *
+   * @tparam KernelT dot product kernel value type (see kernel_functions.h).
+   */
+  template <typename KernelT>
+  Float evaluate(const KernelT& kernel, const Float* x) const {
+    return this->accumulate(
+        x, [](const Float xf, const Float sv) { return xf * sv; },
+        [&kernel](const Float dot12) { return kernel.from_dot(dot12); });
+  }
+
+  /**
+   * @brief RBF overload, on the exact squared distances to the query.
+   */
+  Float evaluate(const kernels::RBF& kernel, const Float* x) const {
+    return this->accumulate(
+        x,
+        [](const Float xf, const Float sv) {
+          const Float d = xf - sv;
+          return d * d;
+        },
+        [&kernel](const Float distance2) {
+          return kernel.from_squared_distance(distance2);
+        });
+  }
+
+ private:
+  using AlignedVector = std::vector<Float, utils::AlignedAllocator<Float>>;
+
+  /**
+   * @brief sum_i coefficient_i value(sum_f term(x_f, sv_i,f)).
+   */
+  template <typename TermT, typename ValueT>
+  Float accumulate(const Float* x, const TermT& term,
+                   const ValueT& value) const {
+    const std::size_t n_features = this->_n_features;
+    Float total = 0.0;
+    for (std::size_t b = 0; b < this->_n_blocks; ++b) {
+      const Float* block = this->_vectors.data() + b * kBlockSize * n_features;
+      alignas(64) Float sums[kBlockSize] = {};
+      for (std::size_t f = 0; f < n_features; ++f) {
+        const Float xf = x[f];
+        const Float* lanes = block + f * kBlockSize;
+        for (std::size_t l = 0; l < kBlockSize; ++l) {
+          sums[l] += term(xf, lanes[l]);
+        }
+      }
+
+      // The padding lanes are skipped, value() may not be finite on them
+      // (e.g. a fractional power of a negative number).
+      const std::size_t n_lanes =
+          std::min(kBlockSize, this->_n_support - b * kBlockSize);
+      const Float* coefficients = this->_coefficients.data() + b * kBlockSize;
+      for (std::size_t l = 0; l < n_lanes; ++l) {
+        total += coefficients[l] * value(sums[l]);
+      }
+    }
+    return total;
+  }
+
+  std::size_t _n_support = 0;
+  std::size_t _n_features = 0;
+  std::size_t _n_blocks = 0;
+  AlignedVector _vectors;
+  AlignedVector _coefficients;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_PACKED_SUPPORT_H
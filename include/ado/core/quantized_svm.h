@@ -0,0 +1,110 @@
+#ifndef ADO_CORE_QUANTIZED_SVM_H
+#define ADO_CORE_QUANTIZED_SVM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ado/core/kernel.h"
+#include "ado/core/svm.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Inference-only SVM with int8 quantized support vectors.
+ *
+ * Every feature f of the support vectors is centered and scaled before being
+ * stored as q = round((x_f - o_f) / s_f), with o_f the middle of the range
+ * of the feature over the support vectors and s_f its half-width / 127,
+ * which cuts the support vector storage by 8x with respect to SVM. At
+ * inference the centered and scaled query (x_f - o_f) * s_f is quantized
+ * with a per-query scale, so the dot products with the support vectors are
+ * int8 x int8 products accumulated in int32 (AVX2 madd, or VNNI dpwssd when
+ * available).
+ *
+ * The kernels are evaluated on the centered values: RBF distances are
+ * recovered as |x'|^2 + |sv'|^2 - 2 x'.sv', whose error is proportional to
+ * the spread of the data rather than to its distance from the origin, and
+ * dot products as x'.sv' + x'.o + sv'.o + |o|^2 with the terms of the support
+ * vectors cached at construction.
+ *
+ * The quantization error depends on the data, use max_error to measure it
+ * against the original model before deploying a quantized model.
+ */
+class QuantizedSVM {
+ public:
+  /**
+   * @brief Construct a new QuantizedSVM object
+   *
+   * @param svm fitted SVM model.
+   */
+  explicit QuantizedSVM(const SVM& svm);
+
+  /**
+   * @brief Run inference and return the predicted labels.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the predicted labels. The array has
+   * shape (N) and binary values [-1, 1]. With N number of samples.
+   */
+  FloatArray predict(const FloatArray& x) const;
+
+  /**
+   * @brief Run inference and return the un-thresholded predicted values.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the un-thresholded predicted values.
+   * The array has shape (N) and real values. With N number of samples.
+   */
+  FloatArray decision_function(const FloatArray& x) const;
+
+  /**
+   * @brief Maximum absolute deviation from the fp64 decision function.
+   *
+   * @param reference SVM model the quantized model was built from.
+   * @param x multi-dimensional array containing the validation data, with
+   * shape (N,M).
+   * @return Float max_i |f_q(x_i) - f(x_i)|.
+   */
+  Float max_error(const SVM& reference, const FloatArray& x) const;
+
+  /**
+   * @brief Number of bytes used to store the support vectors.
+   */
+  inline std::size_t storage_size() const { return this->_support.size(); }
+
+ private:
+  /**
+   * @brief Kernel value from the centered dot product, the squared norm and
+   * the dot product with the offsets of the centered query.
+   */
+  Float kernel_value(const Float dot, const Float x_norm2,
+                     const Float x_offsets, const std::size_t sv) const;
+
+  KernelType _kernel_type = KernelType::Polynomial;
+  Float _degree = 1.0;
+  Float _gamma = 1.0;
+  Float _coeff = 0.0;
+
+  std::size_t _n_support = 0;
+  std::size_t _n_features = 0;
+  std::size_t _row_size = 0;
+
+  std::vector<std::int8_t> _support;
+  std::vector<Float> _offsets;
+  std::vector<Float> _scales;
+  Float _offsets_norm2 = 0.0;
+  // |sv'|^2 and sv'.o of the centered, dequantized support vectors.
+  std::vector<Float> _support_norms2;
+  std::vector<Float> _support_offsets;
+  std::vector<Float> _coefficients;
+  Float _b = 0.0;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_QUANTIZED_SVM_H
@@ -0,0 +1,122 @@
+#ifndef ADO_CORE_RBF_INDEX_H
+#define ADO_CORE_RBF_INDEX_H
+
+#include <vector>
+
+#include "ado/core/svm.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Inference index over the support vectors of an RBF SVM.
+ *
+ * The support vectors are organized in a ball tree. Every node stores the
+ * bounding ball of its support vectors and the sums of their positive and
+ * negative coefficients (alpha_i y_i), so that for a query x the kernel
+ * values of the whole node are bounded by exp(-gamma d_max^2) and
+ * exp(-gamma d_min^2), with d_min and d_max the distances from x to the ball.
+ *
+ * A node whose contribution interval is narrow enough is replaced by the
+ * midpoint of the interval, without evaluating its support vectors. The
+ * tolerance is shared between the nodes in proportion to their coefficients,
+ * hence |f_index(x) - f(x)| <= tolerance for every query, and the bound
+ * actually reached is reported. With a large gamma most of the tree is pruned
+ * and only the support vectors close to the query are evaluated.
+ */
+class RBFIndex {
+ public:
+  /**
+   * @brief Construct a new RBFIndex object
+   *
+   * @param svm fitted SVM model with a KernelRBF kernel.
+   * @param tolerance maximum absolute error of the decision function, 0 for
+   * exact pruning (only the contributions that are exactly 0 are skipped).
+   * @param leaf_size maximum number of support vectors in a leaf.
+   */
+  RBFIndex(const SVM& svm, const Float tolerance,
+           const std::size_t leaf_size = 32);
+
+  /**
+   * @brief Run inference and return the predicted labels.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the predicted labels. The array has
+   * shape (N) and binary values [-1, 1]. With N number of samples.
+   */
+  FloatArray predict(const FloatArray& x) const;
+
+  /**
+   * @brief Run inference and return the un-thresholded predicted values.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the un-thresholded predicted values.
+   * The array has shape (N) and real values. With N number of samples.
+   */
+  FloatArray decision_function(const FloatArray& x) const;
+
+  /**
+   * @brief Run inference on borrowed data.
+   *
+   * @param x view over the input data, with shape (N,M).
+   * @param out buffer of N values receiving the predictions.
+   * @param error_bounds optional buffer of N values receiving the bound on
+   * the absolute error of each prediction.
+   * @param n_evaluated optional buffer of N values receiving the number of
+   * kernel evaluations of each prediction.
+   */
+  void decision_function(const MatrixView& x, Float* out,
+                         Float* error_bounds = nullptr,
+                         std::size_t* n_evaluated = nullptr) const;
+
+  inline Float tolerance() const { return this->_tolerance; }
+  inline std::size_t n_support() const { return this->_coefficients.size(); }
+  inline std::size_t n_nodes() const { return this->_nodes.size(); }
+
+ private:
+  struct Node {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    // Children indexes, 0 for a leaf (the root is never a child).
+    std::size_t left = 0;
+    std::size_t right = 0;
+    Float radius = 0.0;
+    Float positive = 0.0;
+    Float negative = 0.0;
+  };
+
+  /**
+   * @brief Build the subtree over the support vectors [begin, end) of order.
+   */
+  std::size_t build(const FloatArray& x_support,
+                    std::vector<std::size_t>& order, const std::size_t begin,
+                    const std::size_t end);
+
+  /**
+   * @brief Accumulate the contribution of a subtree to the query x.
+   */
+  void query(const Float* x, const std::size_t node, Float& value,
+             Float& error_bound, std::size_t& n_evaluated) const;
+
+  Float _gamma = 1.0;
+  Float _b = 0.0;
+  Float _tolerance = 0.0;
+  Float _total = 0.0;
+  std::size_t _leaf_size = 32;
+  std::size_t _n_features = 0;
+
+  std::vector<Node> _nodes;
+  // Node centers, row-major with shape (n_nodes, n_features).
+  std::vector<Float> _centers;
+  // Support vectors in tree order, row-major with shape (S, n_features).
+  std::vector<Float> _support;
+  std::vector<Float> _coefficients;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_RBF_INDEX_H
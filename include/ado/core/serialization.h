@@ -0,0 +1,29 @@
+#ifndef ADO_CORE_SERIALIZATION_H
+#define ADO_CORE_SERIALIZATION_H
+
+#include <string>
+
+#include "ado/core/svm.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Save the fitted state of an SVM in a binary file.
+ *
+ * Layout, in native byte order: the 8 bytes magic "ADOSVM01", the kernel type
+ * (uint64), degree, gamma and coeff (Float), the bias (Float), the number of
+ * support vectors S and of features M (uint64), then the (S,M) support vectors
+ * row-major, their S labels and their S multipliers.
+ */
+void save_model(const SVM& svm, const std::string& filepath);
+
+/**
+ * @brief Load an SVM saved with save_model, ready for inference.
+ */
+SVM load_model(const std::string& filepath);
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_SERIALIZATION_H
@@ -0,0 +1,98 @@
+#ifndef ADO_CORE_SIGN_PREDICTOR_H
+#define ADO_CORE_SIGN_PREDICTOR_H
+
+#include <vector>
+
+#include "ado/core/kernel.h"
+#include "ado/core/kernel_functions.h"
+#include "ado/core/svm.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace core {
+
+/**
+ * @brief Exact label prediction stopping as soon as the sign is known.
+ *
+ * The support vectors are sorted by decreasing |alpha_i y_i| and the decision
+ * value is accumulated in that order. Every check_interval terms, the
+ * remaining terms are bounded with the kernel range: 0 < K <= 1 for RBF,
+ * |K| <= 1 for sigmoid, and |K| <= (|gamma| |x| |sv| + |coeff|)^degree for
+ * polynomial kernels, with the largest remaining support vector norm. The
+ * accumulation stops once the remaining terms cannot flip the sign, so the
+ * queries far from the margin only evaluate the largest coefficients. The
+ * predicted labels are those of SVM::predict, up to the rounding of decision
+ * values within a few ulps of 0.
+ */
+class SignPredictor {
+ public:
+  /**
+   * @brief Construct a new SignPredictor object
+   *
+   * @param svm fitted SVM model.
+   * @param check_interval number of terms accumulated between two bound
+   * checks.
+   */
+  explicit SignPredictor(const SVM& svm, const std::size_t check_interval = 8);
+
+  /**
+   * @brief Predicted label of a query of n_features() values.
+   *
+   * @param terms_evaluated if not null, receives the number of support
+   * vectors evaluated.
+   * @return Float -1 or 1, 0 if the decision value is exactly 0.
+   */
+  Float predict_sign(const Float* x,
+                     std::size_t* terms_evaluated = nullptr) const;
+
+  /**
+   * @brief Run inference and return the predicted labels.
+   *
+   * @param x multi-dimensional array containing the input data. The array
+   * must have shape (N,M), with N number of samples, and M number of features.
+   * @return FloatArray array containing the predicted labels. The array has
+   * shape (N) and binary values [-1, 1]. With N number of samples.
+   */
+  FloatArray predict(const FloatArray& x) const;
+
+  /**
+   * @brief Run inference on borrowed data and write the predicted labels to a
+   * caller-provided buffer of N values.
+   *
+   * @param terms_evaluated if not null, buffer of N values receiving the
+   * number of support vectors evaluated for every query.
+   */
+  void predict(const MatrixView& x, Float* out,
+               std::size_t* terms_evaluated = nullptr) const;
+
+  inline std::size_t n_support() const { return this->_coefficients.size(); }
+  inline std::size_t n_features() const { return this->_n_features; }
+
+ private:
+  template <typename KernelT, typename BoundT>
+  Float accumulate(const KernelT& kernel, const BoundT& remaining,
+                   const Float* x, std::size_t* terms_evaluated) const;
+
+  KernelType _type = KernelType::RBF;
+  kernels::Polynomial _polynomial;
+  kernels::RBF _rbf;
+  kernels::Sigmoid _sigmoid;
+  Float _b = 0.0;
+  std::size_t _n_features = 0;
+  std::size_t _check_interval = 8;
+
+  // Support vectors and coefficients by decreasing |coefficient|.
+  std::vector<Float> _support;
+  std::vector<Float> _coefficients;
+  // Sums of the positive, negative and absolute coefficients, and largest
+  // norm, of the support vectors from i on, with a trailing 0.
+  std::vector<Float> _positive_suffix;
+  std::vector<Float> _negative_suffix;
+  std::vector<Float> _absolute_suffix;
+  std::vector<Float> _norm_suffix;
+};
+
+}  // namespace core
+}  // namespace ado
+
+#endif  // ADO_CORE_SIGN_PREDICTOR_H
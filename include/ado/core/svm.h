@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "ado/core/basic_svm.h"
 #include "ado/core/kernel.h"
 #include "ado/core/model.h"
 #include "ado/types.h"
@@ -10,6 +11,18 @@
 namespace ado {
 namespace core {
 
+/**
+ * @brief Outcome of SVM::compress.
+ */
+struct CompressionReport {
+  std::size_t n_support_before = 0;
+  std::size_t n_support_after = 0;
+  // Relative RKHS distance ||w - w'|| / ||w|| between the two models.
+  Float relative_error = 0.0;
+  // Maximum absolute decision value difference over the original SVs.
+  Float max_decision_error = 0.0;
+};
+
 /**
  * @brief Support Vector Machine (SVM) model.
  *
@@ -21,6 +34,10 @@ namespace core {
  * support vector machines." (1998).
  * https://www.microsoft.com/en-us/research/wp-content/uploads/2016/02/tr-98-14.pdf
  *
+ * The solver itself is implemented by BasicSVM, specialized on the kernel
+ * type: SVM selects the specialization matching the runtime kernel object and
+ * forwards every call to it.
+ *
  */
 class SVM : public Model {
  public:
@@ -68,7 +85,7 @@ class SVM : public Model {
    * @return FloatArray array containing the predicted labels. The array has
    * shape (N) and binary values [-1, 1]. With N number of samples.
    */
-  FloatArray predict(const FloatArray& x) override;
+  FloatArray predict(const FloatArray& x) const override;
 
   /**
    * @brief Run inference and return the un-thresholded predicted values.
@@ -79,58 +96,126 @@ class SVM : public Model {
    * The array has shape (N) and real values. With N number of
    * samples.
    */
-  FloatArray decision_function(const FloatArray& x) override;
+  FloatArray decision_function(const FloatArray& x) const override;
+
+  /**
+   * @brief Fit the model on borrowed data, without copying it.
+   *
+   * @param x view over the training data, with shape (N,M).
+   * @param y view over the target labels, with shape (N) and binary values
+   * [-1, 1].
+   */
+  void fit(const MatrixView& x, const VectorView& y);
+
+  /**
+   * @brief Fit the model out-of-core, caching at most memory_budget bytes of
+   * rows read from the source. See SVMBase::fit.
+   */
+  void fit(const utils::RowSource& x, const VectorView& y,
+           const std::size_t memory_budget);
+
+  /**
+   * @brief Run inference on borrowed data and write the predicted labels to a
+   * caller-provided buffer of N values.
+   */
+  void predict(const MatrixView& x, Float* out) const;
 
- private:
   /**
-   * @brief Evaluate the model.
+   * @brief Run inference on borrowed data and write the un-thresholded
+   * predicted values to a caller-provided buffer of N values.
    */
-  Float eval(const FloatArray& x, const FloatArray& y, const FloatArray& alphas,
-             const FloatArray& xi) const;
+  void decision_function(const MatrixView& x, Float* out) const;
 
   /**
-   * @brief Compute the bias term.
+   * @brief Approximate the fitted model with a bounded number of SVs.
+   *
+   * Reduced-set compression: the support vectors with the largest feature
+   * space contribution |alpha_i y_i| sqrt(K(x_i, x_i)) are kept and their
+   * coefficients are re-fitted by projecting the original decision function
+   * onto their span, i.e. by solving K_zz beta = K_zx (alpha * y).
+   *
+   * @param max_support_vectors maximum number of support vectors to keep.
+   * @return CompressionReport approximation error of the compressed model.
+   */
+  CompressionReport compress(const std::size_t max_support_vectors);
+
+  /**
+   * @brief Limit the time and the kernel evaluations of the next fits, see
+   * TrainingBudget.
+   */
+  inline void set_budget(const TrainingBudget& budget) {
+    this->_model->set_budget(budget);
+  }
+
+  /**
+   * @brief Largest kernel matrix, in bytes, precomputed by fit, see
+   * SVMBase::set_gram_budget.
    */
-  Float compute_b(const Float& e1, const Float& e2, const Float& y1,
-                  const Float& a1, const Float& alph1, const Float& y2,
-                  const Float& a2, const Float& alph2, const Float& k11,
-                  const Float& k12, const Float& k22) const;
+  inline void set_gram_budget(const std::size_t bytes) {
+    this->_model->set_gram_budget(bytes);
+  }
+  inline std::size_t gram_budget() const {
+    return this->_model->gram_budget();
+  }
+
+  /**
+   * @brief Threads computing the kernel matrix, see
+   * SVMBase::set_gram_threads.
+   */
+  inline void set_gram_threads(const std::size_t n_threads) {
+    this->_model->set_gram_threads(n_threads);
+  }
+
   /**
-   * @brief Compute the gamma term.
+   * @brief Whether the last fit was stopped by the budget before converging.
    */
-  Float compute_gamma(const Float& alph1, const Float& alph2, const Float& V,
-                      const Float& k11, const Float& k12, const Float& k22,
-                      const Float& s, const Float& y1, const Float& y2,
-                      const Float& e1, const Float& e2) const;
+  inline bool stopped_early() const { return this->_model->stopped_early(); }
+
+  inline std::size_t kernel_evaluations() const {
+    return this->_model->kernel_evaluations();
+  }
+
   /**
-   * @brief Evaluate the kernel function.
+   * @brief Number of successful SMO steps of the last fit.
    */
-  Float kernel_function(const FloatArray& x1, const FloatArray& x2) const;
+  inline std::size_t iterations() const {
+    return this->_model->iterations();
+  }
 
   /**
-   * @brief Examine example step of the SMO algorithm.
+   * @brief Restore a fitted state (e.g. a model loaded from disk).
+   *
+   * @param x_support array of shape (S,M) containing the support vectors.
+   * @param y_support array of shape (S) containing their labels.
+   * @param alphas array of shape (S) containing their multipliers.
+   * @param b bias term.
    */
-  std::int8_t examine_example(const std::size_t i2, const FloatArray& x,
-                              const FloatArray& y);
+  void set_support(FloatArray x_support, FloatArray y_support,
+                   FloatArray alphas, const Float b);
+
+  inline const Kernel& kernel() const { return *this->_kernel; }
+  inline FloatArray support_vectors() const {
+    return this->_model->support_vectors();
+  }
+  inline std::size_t n_features() const { return this->_model->n_features(); }
+  inline const FloatArray& support_labels() const {
+    return this->_model->support_labels();
+  }
+  inline const FloatArray& alphas() const { return this->_model->alphas(); }
+  inline const SizeArray& support_indices() const {
+    return this->_model->support_indices();
+  }
 
   /**
-   * @brief Take step of the SMO algorithm.
+   * @brief Bias term, the decision function is sum(alpha_i y_i K_i) - b.
    */
-  std::int8_t take_step(const std::size_t i1, const std::size_t i2,
-                        const FloatArray& x, const FloatArray& y,
-                        const Float& y2, const Float& alph2, const Float& e2);
+  inline Float bias() const { return this->_model->bias(); }
 
-  Float _C = 1.0;
-  Float _tol = 1e-3;
+ private:
   std::unique_ptr<Kernel> _kernel =
       std::make_unique<KernelPolynomial>(1.0, 1.0, 0.0);
-  FloatArray _alphas = FloatArray();
-  Float _b = 0.0;
-  FloatArray _errors = FloatArray();
-  FloatArray _x_support = FloatArray();
-  FloatArray _y_support = FloatArray();
-  std::size_t _max_steps = 1e3;
-  std::size_t _seed = 16;
+  std::unique_ptr<SVMBase> _model =
+      std::make_unique<BasicSVM<kernels::Polynomial>>();
 };
 
 }  // namespace core
@@ -0,0 +1,57 @@
+#ifndef ADO_PREPROCESSING_PIPELINE_H
+#define ADO_PREPROCESSING_PIPELINE_H
+
+#include <memory>
+
+#include "ado/core/model.h"
+#include "ado/core/svm.h"
+#include "ado/preprocessing/scaler.h"
+#include "ado/types.h"
+
+namespace ado {
+namespace preprocessing {
+
+/**
+ * @brief Scaler followed by an SVM.
+ *
+ * fit fits the scaler on the training data only, then the SVM on the scaled
+ * data. At inference the rows are scaled chunk by chunk into a small buffer
+ * that stays in cache and is handed to the SVM as a view, so no scaled copy
+ * of the whole input is ever materialized.
+ */
+class Pipeline : public core::Model {
+ public:
+  /**
+   * @brief Construct a new Pipeline object
+   *
+   * @param scaler scaler applied to every input.
+   * @param svm model trained and evaluated on the scaled inputs.
+   * @param chunk_rows number of rows scaled at once at inference.
+   */
+  Pipeline(std::unique_ptr<Scaler> scaler, core::SVM svm,
+           const std::size_t chunk_rows = 256);
+
+  void fit(const FloatArray& x, const FloatArray& y) override;
+  FloatArray fit_predict(const FloatArray& x, const FloatArray& y) override;
+  FloatArray predict(const FloatArray& x) const override;
+  FloatArray decision_function(const FloatArray& x) const override;
+
+  /**
+   * @brief Run inference on borrowed data and write the un-thresholded
+   * predicted values to a caller-provided buffer of N values.
+   */
+  void decision_function(const MatrixView& x, Float* out) const;
+
+  inline const Scaler& scaler() const { return *this->_scaler; }
+  inline const core::SVM& svm() const { return this->_svm; }
+
+ private:
+  std::unique_ptr<Scaler> _scaler;
+  core::SVM _svm;
+  std::size_t _chunk_rows = 256;
+};
+
+}  // namespace preprocessing
+}  // namespace ado
+
+#endif  // ADO_PREPROCESSING_PIPELINE_H
@@ -0,0 +1,131 @@
+#ifndef ADO_PREPROCESSING_SCALER_H
+#define ADO_PREPROCESSING_SCALER_H
+
+#include <memory>
+#include <vector>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace preprocessing {
+
+/**
+ * @brief Per-feature affine scaling, x_f * scale_f + offset_f.
+ *
+ * The statistics are accumulated in a single pass over row-major chunks, the
+ * inner loops run over contiguous features so they vectorize, and large
+ * inputs are split between threads. partial_fit merges a chunk into the
+ * current statistics, so a dataset can be streamed without holding it in
+ * memory; fit is reset followed by partial_fit.
+ */
+class Scaler {
+ public:
+  virtual ~Scaler() = default;
+
+  /**
+   * @brief Fit the scaler on a dataset, forgetting the previous statistics.
+   *
+   * @param x array of shape (N,M).
+   */
+  void fit(const FloatArray& x);
+  void fit(const MatrixView& x);
+
+  /**
+   * @brief Update the statistics with a chunk of rows.
+   *
+   * @param x view over a chunk of shape (N,M), M must match previous chunks.
+   */
+  virtual void partial_fit(const MatrixView& x) = 0;
+
+  /**
+   * @brief Forget the fitted statistics.
+   */
+  virtual void reset() = 0;
+
+  /**
+   * @brief Scale a dataset into a new array of shape (N,M).
+   */
+  FloatArray transform(const FloatArray& x) const;
+
+  /**
+   * @brief Scale a dataset in place, without allocating.
+   */
+  void transform_inplace(FloatArray& x) const;
+
+  /**
+   * @brief Scale borrowed rows into a caller-provided row-major buffer of
+   * N * M values, which may alias the input if it is contiguous.
+   */
+  void transform(const MatrixView& x, Float* out) const;
+
+  FloatArray fit_transform(const FloatArray& x);
+
+  inline std::size_t n_features() const { return this->_scale.size(); }
+  inline const std::vector<Float>& scale() const { return this->_scale; }
+  inline const std::vector<Float>& offset() const { return this->_offset; }
+
+  virtual std::unique_ptr<Scaler> clone() const = 0;
+
+ protected:
+  /**
+   * @brief Check the number of features of a chunk, and size the statistics
+   * on the first one.
+   *
+   * @return bool whether this is the first chunk.
+   */
+  bool check_features(const std::size_t n_features);
+
+  std::vector<Float> _scale;
+  std::vector<Float> _offset;
+};
+
+/**
+ * @brief Scale every feature to a given range, based on its min and max.
+ */
+class MinMaxScaler : public Scaler {
+ public:
+  explicit MinMaxScaler(const Float min = 0.0, const Float max = 1.0);
+
+  void partial_fit(const MatrixView& x) override;
+  void reset() override;
+  std::unique_ptr<Scaler> clone() const override;
+
+  inline const std::vector<Float>& data_min() const { return this->_min; }
+  inline const std::vector<Float>& data_max() const { return this->_max; }
+
+ private:
+  Float _range_min = 0.0;
+  Float _range_max = 1.0;
+  std::vector<Float> _min;
+  std::vector<Float> _max;
+};
+
+/**
+ * @brief Scale every feature to zero mean and unit variance.
+ *
+ * The chunk statistics are computed around the first row of the chunk, then
+ * merged with the running mean and sum of squared deviations with the
+ * parallel update of Chan et al., which stays accurate for large offsets.
+ */
+class StandardScaler : public Scaler {
+ public:
+  StandardScaler() = default;
+
+  void partial_fit(const MatrixView& x) override;
+  void reset() override;
+  std::unique_ptr<Scaler> clone() const override;
+
+  inline const std::vector<Float>& mean() const { return this->_mean; }
+  std::vector<Float> variance() const;
+  inline std::size_t n_samples() const { return this->_count; }
+
+ private:
+  std::size_t _count = 0;
+  std::vector<Float> _mean;
+  std::vector<Float> _m2;
+};
+
+}  // namespace preprocessing
+}  // namespace ado
+
+#endif  // ADO_PREPROCESSING_SCALER_H
@@ -0,0 +1,53 @@
+#ifndef ADO_SERVING_FILE_SCORING_H
+#define ADO_SERVING_FILE_SCORING_H
+
+#include <string>
+
+#include "ado/core/svm.h"
+
+namespace ado {
+namespace serving {
+
+struct FileScoringOptions {
+  // Rows parsed, scored and written at once.
+  std::size_t chunk_rows = 4096;
+  // Chunk buffers in flight, bounds the memory of the pipeline. Reading,
+  // scoring and writing only overlap with at least n_scorers + 2 buffers.
+  std::size_t n_buffers = 4;
+  // Threads evaluating the model, the output keeps the input order.
+  std::size_t n_scorers = 1;
+  // Write the decision values instead of the predicted labels.
+  bool decision_values = false;
+  char delimiter = ',';
+};
+
+/**
+ * @brief Score a CSV file of samples and write one prediction per line.
+ *
+ * The rows are streamed in chunks through a read -> score -> write pipeline:
+ * a reader thread parses chunks into recycled buffers, the scorer threads
+ * evaluate them and a writer thread writes them back in order, the stages
+ * being connected by bounded queues. Parsing, kernel evaluations and writing
+ * thus overlap, and the memory used does not depend on the file size.
+ *
+ * @param svm fitted model.
+ * @param input_path CSV file with one sample per line, as read by load_data.
+ * @param output_path file receiving one value per input line.
+ * @return std::size_t number of rows scored.
+ */
+std::size_t predict_file(
+    const core::SVM& svm, const std::string& input_path,
+    const std::string& output_path,
+    const FileScoringOptions& options = FileScoringOptions());
+
+/**
+ * @brief predict_file with the default options and chunk_rows rows per chunk.
+ */
+std::size_t predict_file(const core::SVM& svm, const std::string& input_path,
+                         const std::string& output_path,
+                         const std::size_t chunk_rows);
+
+}  // namespace serving
+}  // namespace ado
+
+#endif  // ADO_SERVING_FILE_SCORING_H
@@ -0,0 +1,48 @@
+#ifndef ADO_SERVING_LATENCY_RECORDER_H
+#define ADO_SERVING_LATENCY_RECORDER_H
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace serving {
+
+/**
+ * @brief Thread-safe latency percentiles over a sliding window of requests.
+ *
+ * Keeps the latencies of the last `window` requests in a ring buffer, the
+ * percentiles are computed on demand from a copy of the window.
+ */
+class LatencyRecorder {
+ public:
+  explicit LatencyRecorder(const std::size_t window = 1 << 16);
+
+  void record(const std::chrono::nanoseconds latency);
+
+  /**
+   * @brief Latency percentile in microseconds, 0 without samples.
+   *
+   * @param q percentile in [0, 1], e.g. 0.99 for the p99.
+   */
+  Float percentile(const Float q) const;
+
+  /**
+   * @brief Total number of requests recorded.
+   */
+  std::size_t count() const;
+
+ private:
+  mutable std::mutex _mutex;
+  std::vector<Float> _samples;
+  std::size_t _window = 0;
+  std::size_t _next = 0;
+  std::size_t _count = 0;
+};
+
+}  // namespace serving
+}  // namespace ado
+
+#endif  // ADO_SERVING_LATENCY_RECORDER_H
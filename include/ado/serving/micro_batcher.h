@@ -0,0 +1,83 @@
+#ifndef ADO_SERVING_MICRO_BATCHER_H
+#define ADO_SERVING_MICRO_BATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ado/core/model_registry.h"
+#include "ado/types.h"
+#include "ado/utils/bounded_queue.h"
+
+namespace ado {
+namespace serving {
+
+struct BatchOptions {
+  // A batch is scored as soon as the next request would take it past
+  // max_batch_rows rows, a larger request being scored alone...
+  std::size_t max_batch_rows = 256;
+  // ...or max_delay after its first request was dequeued.
+  std::chrono::microseconds max_delay = std::chrono::microseconds(500);
+  // Pending requests before submit blocks the callers.
+  std::size_t queue_capacity = 1024;
+};
+
+/**
+ * @brief Coalesce concurrent scoring requests into batched model calls.
+ *
+ * Requests submitted from any thread are queued, a worker thread gathers
+ * them into a batch bounded by BatchOptions and scores the whole batch with a
+ * single Model::decision_function call, then fulfills the futures of every
+ * request. The model is looked up in the registry for every batch, so a model
+ * published while serving is picked up by the next batch.
+ */
+class MicroBatcher {
+ public:
+  MicroBatcher(const core::ModelRegistry& registry, std::string model,
+               const BatchOptions& options);
+  ~MicroBatcher();
+
+  MicroBatcher(const MicroBatcher&) = delete;
+  MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+  /**
+   * @brief Queue rows for scoring.
+   *
+   * @param values n_rows rows of n_features values, row-major.
+   * @return std::future<std::vector<Float>> the n_rows decision values, or
+   * the scoring error.
+   */
+  std::future<std::vector<Float>> submit(std::vector<Float> values,
+                                         const std::size_t n_rows,
+                                         const std::size_t n_features);
+
+  inline std::size_t batches() const { return this->_batches.load(); }
+  inline std::size_t rows() const { return this->_rows.load(); }
+
+ private:
+  struct Pending {
+    std::vector<Float> values;
+    std::size_t n_rows = 0;
+    std::size_t n_features = 0;
+    std::promise<std::vector<Float>> result;
+  };
+
+  void run();
+  void score(std::vector<Pending>& batch);
+
+  const core::ModelRegistry& _registry;
+  std::string _model;
+  BatchOptions _options;
+  utils::BoundedQueue<Pending> _queue;
+  std::atomic<std::size_t> _batches{0};
+  std::atomic<std::size_t> _rows{0};
+  std::thread _worker;
+};
+
+}  // namespace serving
+}  // namespace ado
+
+#endif  // ADO_SERVING_MICRO_BATCHER_H
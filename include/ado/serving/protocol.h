@@ -0,0 +1,68 @@
+#ifndef ADO_SERVING_PROTOCOL_H
+#define ADO_SERVING_PROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace serving {
+
+/**
+ * Binary frames exchanged over the scoring socket, in native byte order.
+ *
+ * Request:  RequestHeader, model name (name_size bytes), then n_rows rows of
+ *           n_features Float values, row-major.
+ * Response: ResponseHeader, then either `size` Float decision values
+ *           (Status::Ok, one per row) or a `size` bytes error message.
+ */
+struct RequestHeader {
+  std::uint32_t name_size;
+  std::uint32_t n_rows;
+  std::uint32_t n_features;
+};
+
+enum class Status : std::uint32_t { Ok = 0, Error = 1 };
+
+struct ResponseHeader {
+  std::uint32_t status;
+  std::uint32_t size;
+};
+
+// Upper bounds on the frames accepted from a client.
+constexpr std::uint32_t kMaxNameSize = 256;
+constexpr std::size_t kMaxRequestValues = std::size_t(1) << 24;
+
+struct Request {
+  std::string model;
+  std::size_t n_rows = 0;
+  std::size_t n_features = 0;
+  std::vector<Float> values;
+};
+
+/**
+ * @brief Read a request frame.
+ *
+ * @return bool false if the peer closed the connection before a new frame.
+ * Throws std::runtime_error on a truncated or oversized frame.
+ */
+bool read_request(const int fd, Request& request);
+void write_request(const int fd, const std::string& model,
+                   const Float* values, const std::size_t n_rows,
+                   const std::size_t n_features);
+
+void write_response(const int fd, const std::vector<Float>& values);
+void write_error(const int fd, const std::string& message);
+
+/**
+ * @brief Read a response frame, throws std::runtime_error with the server
+ * message on an error response.
+ */
+std::vector<Float> read_response(const int fd);
+
+}  // namespace serving
+}  // namespace ado
+
+#endif  // ADO_SERVING_PROTOCOL_H
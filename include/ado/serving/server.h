@@ -0,0 +1,92 @@
+#ifndef ADO_SERVING_SERVER_H
+#define ADO_SERVING_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ado/core/model_registry.h"
+#include "ado/serving/latency_recorder.h"
+#include "ado/serving/micro_batcher.h"
+
+namespace ado {
+namespace serving {
+
+/**
+ * @brief Scoring server listening on a Unix domain socket.
+ *
+ * Every connection is served by its own thread, which reads request frames
+ * (see protocol.h) and hands them to the MicroBatcher of the requested model,
+ * so the requests of concurrent clients are scored together. The latency of
+ * every request, from the frame read to the response, is recorded and the
+ * percentiles are logged periodically and on shutdown.
+ */
+class Server {
+ public:
+  /**
+   * @brief Construct a new Server object
+   *
+   * @param socket_path filesystem path of the socket, replaced if it exists.
+   * @param registry models to serve, must outlive the server.
+   * @param models names of the models clients may request.
+   * @param options micro-batching bounds.
+   * @param report_interval period of the latency reports.
+   */
+  Server(std::string socket_path, const core::ModelRegistry& registry,
+         const std::vector<std::string>& models, const BatchOptions& options,
+         const std::chrono::seconds report_interval);
+  ~Server();
+
+  Server(const Server&) = delete;
+  Server& operator=(const Server&) = delete;
+
+  /**
+   * @brief Accept connections until stop is called.
+   */
+  void run();
+
+  /**
+   * @brief Make run return after closing the open connections. Can be called
+   * from any thread.
+   */
+  void stop();
+
+  /**
+   * @brief Log the request count, the batching ratio and the p50/p99
+   * latencies.
+   */
+  void report() const;
+
+  inline const LatencyRecorder& latency() const { return this->_latency; }
+
+ private:
+  void serve(const std::size_t id, const int fd);
+
+  /**
+   * @brief Join the threads of the closed connections.
+   */
+  void reap();
+
+  std::string _socket_path;
+  std::map<std::string, std::unique_ptr<MicroBatcher>> _batchers;
+  std::chrono::seconds _report_interval;
+  LatencyRecorder _latency;
+  std::atomic<bool> _stopping{false};
+
+  std::mutex _connections_mutex;
+  std::set<int> _connections;
+  std::size_t _next_id = 0;
+  std::map<std::size_t, std::thread> _threads;
+  std::vector<std::size_t> _finished;
+};
+
+}  // namespace serving
+}  // namespace ado
+
+#endif  // ADO_SERVING_SERVER_H
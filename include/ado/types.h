@@ -1,6 +1,7 @@
 #ifndef ADO_TYPES_H
 #define ADO_TYPES_H
 
+#include <stdexcept>
 #include <xtensor/xarray.hpp>
 
 namespace ado {
@@ -10,6 +11,56 @@ using FloatArray = xt::xarray<Float>;
 
 using SizeArray = xt::xarray<std::size_t>;
 
+/**
+ * @brief Non-owning view over a 2D array with contiguous rows.
+ *
+ * Row i starts at data + i * row_stride (in elements), so C-contiguous
+ * buffers and row slices of them (e.g. NumPy arrays) can be used in place.
+ */
+struct MatrixView {
+  const Float* data = nullptr;
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::size_t row_stride = 0;
+
+  inline const Float* row(const std::size_t i) const {
+    return this->data + i * this->row_stride;
+  }
+};
+
+/**
+ * @brief Non-owning view over a strided 1D array.
+ */
+struct VectorView {
+  const Float* data = nullptr;
+  std::size_t size = 0;
+  std::size_t stride = 1;
+
+  inline Float operator[](const std::size_t i) const {
+    return this->data[i * this->stride];
+  }
+};
+
+/**
+ * @brief View over a FloatArray of shape (N,M).
+ */
+inline MatrixView make_view(const FloatArray& x) {
+  if (x.dimension() != 2) {
+    throw std::invalid_argument("Expected an array of shape (N,M).");
+  }
+  return MatrixView{x.data(), x.shape(0), x.shape(1), x.shape(1)};
+}
+
+/**
+ * @brief View over a FloatArray of shape (N) or (N,1).
+ */
+inline VectorView make_vector_view(const FloatArray& y) {
+  if (y.dimension() > 2 || (y.dimension() == 2 && y.shape(1) != 1)) {
+    throw std::invalid_argument("Expected an array of shape (N) or (N,1).");
+  }
+  return VectorView{y.data(), y.size(), 1};
+}
+
 }  // namespace ado
 
-#endif  // ADO_TYPES_H
\ No newline at end of file
+#endif  // ADO_TYPES_H
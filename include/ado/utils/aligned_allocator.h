@@ -0,0 +1,55 @@
+#ifndef ADO_UTILS_ALIGNED_ALLOCATOR_H
+#define ADO_UTILS_ALIGNED_ALLOCATOR_H
+
+#include <stdlib.h>
+
+#include <cstddef>
+#include <new>
+
+namespace ado {
+namespace utils {
+
+/**
+ * @brief Allocator returning memory aligned on `Alignment` bytes, e.g. cache
+ * lines, for use with std::vector.
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(const std::size_t n) {
+    void* data = nullptr;
+    if (::posix_memalign(&data, Alignment, n * sizeof(T)) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(data);
+  }
+
+  void deallocate(T* data, const std::size_t) { ::free(data); }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+  return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+  return false;
+}
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_ALIGNED_ALLOCATOR_H
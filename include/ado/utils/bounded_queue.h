@@ -0,0 +1,120 @@
+#ifndef ADO_UTILS_BOUNDED_QUEUE_H
+#define ADO_UTILS_BOUNDED_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+namespace ado {
+namespace utils {
+
+/**
+ * @brief Multi-producer multi-consumer FIFO queue with a bounded capacity.
+ *
+ * push blocks while the queue is full, so a slow consumer applies back
+ * pressure to the producers instead of letting the queue grow. Once closed,
+ * push fails and pop drains the remaining items before failing.
+ *
+ * @tparam T type of the items, must be movable.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(const std::size_t capacity) : _capacity(capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("The queue capacity must be positive.");
+    }
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /**
+   * @brief Append an item, waiting for space if the queue is full.
+   *
+   * @return bool false if the queue was closed, the item is not added.
+   */
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_not_full.wait(lock, [this]() {
+      return this->_closed || this->_items.size() < this->_capacity;
+    });
+    if (this->_closed) return false;
+
+    this->_items.push_back(std::move(item));
+    lock.unlock();
+    this->_not_empty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest item, waiting for one if the queue is empty.
+   *
+   * @return bool false if the queue is closed and empty.
+   */
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_not_empty.wait(
+        lock, [this]() { return this->_closed || !this->_items.empty(); });
+    return this->take(item, lock);
+  }
+
+  /**
+   * @brief Remove the oldest item, waiting for one until the deadline.
+   *
+   * @return bool false on timeout, or if the queue is closed and empty.
+   */
+  template <typename Clock, typename Duration>
+  bool pop_until(T& item,
+                 const std::chrono::time_point<Clock, Duration>& deadline) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_not_empty.wait_until(lock, deadline, [this]() {
+      return this->_closed || !this->_items.empty();
+    });
+    return this->take(item, lock);
+  }
+
+  /**
+   * @brief Reject new items and wake up the waiting producers and consumers.
+   */
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_closed = true;
+    }
+    this->_not_full.notify_all();
+    this->_not_empty.notify_all();
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_items.size();
+  }
+
+  inline std::size_t capacity() const { return this->_capacity; }
+
+ private:
+  bool take(T& item, std::unique_lock<std::mutex>& lock) {
+    if (this->_items.empty()) return false;
+
+    item = std::move(this->_items.front());
+    this->_items.pop_front();
+    lock.unlock();
+    this->_not_full.notify_one();
+    return true;
+  }
+
+  const std::size_t _capacity;
+  std::deque<T> _items;
+  bool _closed = false;
+  mutable std::mutex _mutex;
+  std::condition_variable _not_full;
+  std::condition_variable _not_empty;
+};
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_BOUNDED_QUEUE_H
@@ -11,6 +11,11 @@ using ado::FloatArray;
 FloatArray load_data(const std::string& filepath);
 void save_data(const FloatArray& data, const std::string& filepath);
 
+/**
+ * @brief Save a 2D array in the binary layout read by utils::MappedMatrix.
+ */
+void save_binary(const FloatArray& data, const std::string& filepath);
+
 }  // namespace utils
 }  // namespace ado
 
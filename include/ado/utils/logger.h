@@ -1,6 +1,7 @@
 #ifndef ADO_UTILS_LOGGER_H
 #define ADO_UTILS_LOGGER_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -18,6 +19,12 @@ class Logger {
 
   void register_handler(std::unique_ptr<LoggerHandler> handler);
 
+  /**
+   * @brief Drop every message while disabled, without taking the logger
+   * mutex (e.g. in a forked child, where the mutex may be held forever).
+   */
+  inline void set_enabled(const bool enabled) { this->_enabled = enabled; }
+
   LoggerBuffer operator<<(const LogLevel& type) {
     return LoggerBuffer(type,
                         std::bind(&Logger::log, this, std::placeholders::_1,
@@ -34,6 +41,7 @@ class Logger {
 
   std::vector<std::unique_ptr<LoggerHandler>> _handlers;
   std::mutex _mutex;
+  std::atomic<bool> _enabled{true};
 };
 
 }  // namespace utils
@@ -0,0 +1,49 @@
+#ifndef ADO_UTILS_MAPPED_MATRIX_H
+#define ADO_UTILS_MAPPED_MATRIX_H
+
+#include <string>
+
+#include "ado/types.h"
+#include "ado/utils/row_source.h"
+
+namespace ado {
+namespace utils {
+
+/**
+ * @brief Read-only, memory-mapped, row-major matrix of Float values.
+ *
+ * The file layout is the one written by utils::save_binary: two uint64 values
+ * (number of rows, number of columns) followed by the row-major data. Rows are
+ * paged in on demand by the operating system, so datasets larger than the
+ * available memory can be traversed without loading them.
+ */
+class MappedMatrix : public RowSource {
+ public:
+  explicit MappedMatrix(const std::string& filepath);
+  ~MappedMatrix();
+
+  MappedMatrix(const MappedMatrix&) = delete;
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+  inline std::size_t rows() const override { return this->_rows; }
+  inline std::size_t cols() const override { return this->_cols; }
+  inline const Float* data() const { return this->_data; }
+  inline const Float* row(const std::size_t i) const {
+    return this->_data + i * this->_cols;
+  }
+
+  void read_rows(const std::size_t first, const std::size_t count,
+                 Float* out) const override;
+
+ private:
+  void* _mapping = nullptr;
+  std::size_t _mapping_size = 0;
+  const Float* _data = nullptr;
+  std::size_t _rows = 0;
+  std::size_t _cols = 0;
+};
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_MAPPED_MATRIX_H
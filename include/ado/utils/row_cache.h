@@ -0,0 +1,72 @@
+#ifndef ADO_UTILS_ROW_CACHE_H
+#define ADO_UTILS_ROW_CACHE_H
+
+#include <vector>
+
+#include "ado/types.h"
+#include "ado/utils/row_source.h"
+
+namespace ado {
+namespace utils {
+
+/**
+ * @brief Least recently used cache of the rows of a RowSource.
+ *
+ * The cache holds at most memory_budget bytes of rows (and never less than two
+ * rows), so the memory used to access a dataset is bounded independently of
+ * its size. A pointer returned by row() stays valid until the next call to
+ * row(), plus one more call if that one is for a different row: the pair
+ * (row(i), row(j)) can be used together. The cache is not thread-safe.
+ */
+class RowCache {
+ public:
+  /**
+   * @brief Construct a new RowCache object
+   *
+   * @param source rows to cache, must outlive the cache.
+   * @param memory_budget maximum number of bytes used by the cached rows.
+   */
+  RowCache(const RowSource& source, const std::size_t memory_budget);
+
+  inline std::size_t rows() const { return this->_source.rows(); }
+  inline std::size_t cols() const { return this->_source.cols(); }
+
+  /**
+   * @brief Pointer to the cols() values of row i, read from the source on a
+   * cache miss.
+   */
+  const Float* row(const std::size_t i);
+
+  inline std::size_t capacity() const { return this->_capacity; }
+  inline std::size_t hits() const { return this->_hits; }
+  inline std::size_t misses() const { return this->_misses; }
+
+ private:
+  static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+  void unlink(const std::size_t slot);
+  void push_front(const std::size_t slot);
+
+  const RowSource& _source;
+  std::size_t _capacity = 0;
+  std::vector<Float> _storage;
+
+  // Intrusive doubly linked list of the slots, most recently used first.
+  std::vector<std::size_t> _slot_row;
+  std::vector<std::size_t> _prev;
+  std::vector<std::size_t> _next;
+  std::size_t _head = kNone;
+  std::size_t _tail = kNone;
+  std::size_t _used = 0;
+  // Slot of every row of the source, kNone if not cached: O(rows) like the
+  // solver state, and no allocation or hashing per access.
+  std::vector<std::size_t> _row_slot;
+
+  std::size_t _hits = 0;
+  std::size_t _misses = 0;
+};
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_ROW_CACHE_H
@@ -0,0 +1,62 @@
+#ifndef ADO_UTILS_ROW_SOURCE_H
+#define ADO_UTILS_ROW_SOURCE_H
+
+#include <string>
+
+#include "ado/types.h"
+
+namespace ado {
+namespace utils {
+
+/**
+ * @brief Random access to the rows of a row-major matrix stored elsewhere
+ * (file, memory map, remote chunks, ...).
+ */
+class RowSource {
+ public:
+  virtual ~RowSource() = default;
+
+  virtual std::size_t rows() const = 0;
+  virtual std::size_t cols() const = 0;
+
+  /**
+   * @brief Copy consecutive rows to a row-major buffer.
+   *
+   * @param first index of the first row.
+   * @param count number of rows to copy.
+   * @param out buffer of count * cols() values.
+   */
+  virtual void read_rows(const std::size_t first, const std::size_t count,
+                         Float* out) const = 0;
+};
+
+/**
+ * @brief Chunk reader over a file written by utils::save_binary.
+ *
+ * Rows are read with positioned reads on demand and nothing is kept in
+ * memory, pair it with a RowCache to bound the memory used by the hot rows.
+ */
+class BinaryRowFile : public RowSource {
+ public:
+  explicit BinaryRowFile(const std::string& filepath);
+  ~BinaryRowFile();
+
+  BinaryRowFile(const BinaryRowFile&) = delete;
+  BinaryRowFile& operator=(const BinaryRowFile&) = delete;
+
+  inline std::size_t rows() const override { return this->_rows; }
+  inline std::size_t cols() const override { return this->_cols; }
+
+  void read_rows(const std::size_t first, const std::size_t count,
+                 Float* out) const override;
+
+ private:
+  int _fd = -1;
+  std::size_t _rows = 0;
+  std::size_t _cols = 0;
+};
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_ROW_SOURCE_H
@@ -0,0 +1,175 @@
+#ifndef ADO_UTILS_TRACE_H
+#define ADO_UTILS_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Scoped tracing spans.
+ *
+ * ADO_TRACE_SCOPE("name") records the duration of the enclosing scope in the
+ * trace buffer of the calling thread. The spans are only compiled when
+ * ADO_ENABLE_TRACING is defined, otherwise the macro expands to nothing and
+ * the Tracer stays empty. The name must be a string literal.
+ */
+#define ADO_TRACE_CONCAT_IMPL(a, b) a##b
+#define ADO_TRACE_CONCAT(a, b) ADO_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ADO_ENABLE_TRACING
+#define ADO_TRACE_SCOPE(name) \
+  ::ado::utils::TraceSpan ADO_TRACE_CONCAT(ado_trace_span_, __LINE__)(name)
+#else
+#define ADO_TRACE_SCOPE(name)
+#endif
+
+namespace ado {
+namespace utils {
+
+struct TraceEvent {
+  const char* name;
+  std::uint64_t start_ns;
+  std::uint64_t duration_ns;
+  std::uint64_t cycles;
+  std::uint64_t cache_misses;
+  // Whether cycles and cache_misses were read from counters of the thread.
+  bool counted;
+};
+
+/**
+ * @brief Bounded event buffer written by a single thread at a time.
+ *
+ * The events are stored in chunks of kChunkEvents allocated as the buffer
+ * fills, up to the capacity. The owning thread appends without locking and
+ * publishes the new size with a release store, the exporter reads up to the
+ * size loaded with acquire. Events past the capacity are counted as dropped.
+ */
+struct TraceBuffer {
+  static constexpr std::size_t kChunkEvents = 1024;
+
+  TraceBuffer(const std::uint32_t thread_id, const std::size_t capacity);
+  ~TraceBuffer();
+
+  /**
+   * @brief Append an event, called by the owning thread only.
+   */
+  void push(const TraceEvent& event);
+
+  /**
+   * @brief Event i, for i below the size loaded with acquire.
+   */
+  inline const TraceEvent& event(const std::size_t i) const {
+    return this->chunks[i / kChunkEvents].load(std::memory_order_relaxed)
+        [i % kChunkEvents];
+  }
+
+  /**
+   * @brief Free the chunks and reset the size, while no event is recorded.
+   */
+  void clear();
+
+  std::uint32_t thread_id;
+  std::size_t capacity;
+  std::unique_ptr<std::atomic<TraceEvent*>[]> chunks;
+  std::atomic<std::size_t> size{0};
+  std::atomic<std::size_t> dropped{0};
+
+  // perf_event_open file descriptors of the owning thread, -1 when not
+  // available.
+  int cycles_fd = -1;
+  int cache_misses_fd = -1;
+};
+
+class Tracer {
+ public:
+  static Tracer& get();
+
+  /**
+   * @brief Read the CPU cycles and cache misses of every span, with
+   * perf_event_open (Linux only). Applies to the threads that record their
+   * first span after the call.
+   */
+  void enable_counters(const bool enabled);
+  inline bool counters_enabled() const { return this->_counters.load(); }
+
+  /**
+   * @brief Maximum events per thread buffer, for the buffers created
+   * afterwards.
+   */
+  void set_capacity(const std::size_t capacity);
+
+  /**
+   * @brief Trace buffer of the calling thread, taken on first use.
+   *
+   * When a thread exits its buffer, with its events, is handed to the next
+   * thread that records a span, so the memory is bounded by the number of
+   * threads alive at once rather than by the number of threads ever created.
+   * The trace thread ids therefore identify buffers, reused in sequence.
+   */
+  TraceBuffer& buffer();
+
+  /**
+   * @brief Nanoseconds elapsed since the tracer creation.
+   */
+  std::uint64_t now() const;
+
+  /**
+   * @brief Export the recorded events in the Chrome trace_event JSON format,
+   * viewable in chrome://tracing or Perfetto.
+   */
+  std::string chrome_trace() const;
+  void write_chrome_trace(const std::string& filepath) const;
+
+  /**
+   * @brief Discard the recorded events and free their memory. Must not be
+   * called while spans are being recorded.
+   */
+  void clear();
+
+ private:
+  friend struct TraceBufferHolder;
+
+  Tracer();
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  /**
+   * @brief Make the buffer of an exiting thread available to other threads.
+   */
+  void release(TraceBuffer* buffer);
+
+  std::atomic<bool> _counters{false};
+  std::size_t _capacity = 1 << 16;
+  std::uint64_t _origin = 0;
+
+  mutable std::mutex _mutex;
+  std::vector<std::unique_ptr<TraceBuffer>> _buffers;
+  std::vector<TraceBuffer*> _free;
+};
+
+/**
+ * @brief Span recorded from its construction to its destruction.
+ */
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  TraceBuffer& _buffer;
+  const char* _name;
+  std::uint64_t _start = 0;
+  std::uint64_t _cycles = 0;
+  std::uint64_t _cache_misses = 0;
+};
+
+}  // namespace utils
+}  // namespace ado
+
+#endif  // ADO_UTILS_TRACE_H
@@ -0,0 +1,556 @@
+#include "ado/core/basic_svm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xsort.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ado/core/gram_matrix.h"
+#include "ado/utils/logger.h"
+#include "ado/utils/row_cache.h"
+#include "ado/utils/trace.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+
+Float clip_value(const Float value, const Float high, const Float low) {
+  if (value < low) return low;
+  if (value > high) return high;
+  return value;
+}
+
+/**
+ * Evaluator counting the kernel evaluations of another one.
+ */
+template <typename EvaluatorT>
+class CountingEvaluator {
+ public:
+  CountingEvaluator(const EvaluatorT& k, std::size_t& count)
+      : _k(k), _count(count) {}
+
+  inline Float operator()(const std::size_t i, const std::size_t j) const {
+    ++this->_count;
+    return this->_k(i, j);
+  }
+
+ private:
+  const EvaluatorT& _k;
+  std::size_t& _count;
+};
+
+/**
+ * K(x_i, x_j) over the rows of a matrix view.
+ */
+template <typename KernelT>
+class RowEvaluator {
+ public:
+  RowEvaluator(const KernelT& kernel, const ado::MatrixView& x)
+      : _kernel(kernel), _x(x) {}
+
+  inline Float operator()(const std::size_t i, const std::size_t j) const {
+    return this->_kernel(this->_x.row(i), this->_x.row(j), this->_x.cols);
+  }
+
+ private:
+  const KernelT& _kernel;
+  const ado::MatrixView& _x;
+};
+
+/**
+ * K(x_i, x_j) over the rows of a row cache.
+ */
+template <typename KernelT>
+class CachedRowEvaluator {
+ public:
+  CachedRowEvaluator(const KernelT& kernel, ado::utils::RowCache& cache)
+      : _kernel(kernel), _cache(cache) {}
+
+  inline Float operator()(const std::size_t i, const std::size_t j) const {
+    // The cache keeps both rows alive until the kernel is evaluated.
+    const Float* xi = this->_cache.row(i);
+    const Float* xj = this->_cache.row(j);
+    return this->_kernel(xi, xj, this->_cache.cols());
+  }
+
+ private:
+  const KernelT& _kernel;
+  ado::utils::RowCache& _cache;
+};
+
+/**
+ * K(x_i, x_j) looked up in a precomputed kernel matrix.
+ */
+class GramEvaluator {
+ public:
+  explicit GramEvaluator(const ado::core::GramMatrix& gram) : _gram(gram) {}
+
+  inline Float operator()(const std::size_t i, const std::size_t j) const {
+    return this->_gram(i, j);
+  }
+
+ private:
+  const ado::core::GramMatrix& _gram;
+};
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+using ado::utils::LogLevel;
+
+// SVMBase.
+
+SVMBase::SVMBase(const Float C, const Float tol, const std::size_t max_steps,
+                 const std::size_t seed)
+    : _C(C), _tol(tol), _max_steps(max_steps), _seed(seed), _engine(seed) {}
+
+FloatArray SVMBase::fit_predict(const FloatArray& x, const FloatArray& y) {
+  this->fit(x, y);
+  return this->predict(x);
+}
+
+void SVMBase::predict(const MatrixView& x, Float* out) const {
+  this->decision_function(x, out);
+  for (std::size_t idx = 0; idx < x.rows; ++idx) {
+    if (out[idx] < 0) out[idx] = -1;
+    if (out[idx] > 0) out[idx] = 1;
+  }
+}
+
+FloatArray SVMBase::predict(const FloatArray& x) const {
+  auto y_hat = this->decision_function(x);
+  filtration(y_hat, y_hat < 0) = -1;
+  filtration(y_hat, y_hat > 0) = 1;
+  return y_hat;
+}
+
+void SVMBase::set_support(FloatArray x_support, FloatArray y_support,
+                          FloatArray alphas, const Float b) {
+  if ((x_support.shape(0) != y_support.size()) ||
+      (y_support.size() != alphas.size())) {
+    throw std::invalid_argument("Inconsistent number of support vectors.");
+  }
+  this->_y_support = std::move(y_support);
+  this->_alphas = std::move(alphas);
+  this->_b = b;
+  this->_support_indices = SizeArray();
+  this->pack_support(x_support);
+}
+
+void SVMBase::pack_support(const FloatArray& x_support) {
+  this->_packed = PackedSupport(x_support, this->_alphas * this->_y_support);
+}
+
+void SVMBase::start_budget() {
+  this->_kernel_evaluations = 0;
+  this->_stopped_early = false;
+  this->_deadline = std::chrono::steady_clock::now() + this->_budget.time_limit;
+}
+
+bool SVMBase::budget_exhausted() {
+  if (this->_stopped_early) return true;
+
+  const auto& budget = this->_budget;
+  if ((budget.max_kernel_evaluations > 0 &&
+       this->_kernel_evaluations >= budget.max_kernel_evaluations) ||
+      (budget.time_limit.count() > 0 &&
+       std::chrono::steady_clock::now() >= this->_deadline)) {
+    this->_stopped_early = true;
+  }
+  return this->_stopped_early;
+}
+
+Float SVMBase::compute_b(const Float& e1, const Float& e2, const Float& y1,
+                         const Float& a1, const Float& alph1, const Float& y2,
+                         const Float& a2, const Float& alph2, const Float& k11,
+                         const Float& k12, const Float& k22) const {
+  const auto b1 =
+      e1 + y1 * (a1 - alph1) * k11 + y2 * (a2 - alph2) * k12 + this->_b;
+  const auto b2 =
+      e2 + y1 * (a1 - alph1) * k12 + y2 * (a2 - alph2) * k22 + this->_b;
+
+  if ((a1 > 0) && (a1 < this->_C))
+    return b1;
+  else if ((a2 > 0) && (a2 < this->_C))
+    return b2;
+  else
+    return (b1 + b2) / 2.0;
+}
+
+Float SVMBase::compute_gamma(const Float& alph1, const Float& alph2,
+                             const Float& V, const Float& k11,
+                             const Float& k12, const Float& k22,
+                             const Float& s, const Float& y1, const Float& y2,
+                             const Float& e1, const Float& e2) const {
+  const auto f1 = y1 * (e1 + this->_b) - alph1 * k11 - s * alph2 * k12;
+  const auto f2 = y2 * (e2 + this->_b) - s * alph1 * k12 - alph2 * k22;
+  const auto V1 = alph1 + s * (alph2 - V);
+  return V1 * f1 + V * f2 + 0.5 * (V1 * V1) * k11 + 0.5 * (V * V) * k22 +
+         s * V * V1 * k12;
+}
+
+// BasicSVM.
+
+template <typename KernelT>
+BasicSVM<KernelT>::BasicSVM(const Float C, const Float tol,
+                            const KernelT& kernel, const std::size_t max_steps,
+                            const std::size_t seed)
+    : SVMBase(C, tol, max_steps, seed), _kernel(kernel) {}
+
+template <typename KernelT>
+void BasicSVM<KernelT>::fit(const FloatArray& x, const FloatArray& y) {
+  this->fit(make_view(x), make_vector_view(y));
+}
+
+template <typename KernelT>
+void BasicSVM<KernelT>::fit(const MatrixView& x, const VectorView& y) {
+  ADO_TRACE_SCOPE("fit");
+  const std::size_t n_samples = x.rows;
+  const std::size_t n_features = x.cols;
+  if (y.size != n_samples) {
+    throw std::invalid_argument("The number of labels must match the samples.");
+  }
+
+  logger << LogLevel::Info << "Fitting " << n_samples
+         << " samples for a maximum of " << this->_max_steps << " steps.";
+
+  // The budget covers the kernel matrix, which is not precomputed when it
+  // would use up the kernel evaluations, and is interrupted at the deadline.
+  this->start_budget();
+  const auto& budget = this->_budget;
+  std::unique_ptr<GramMatrix> gram;
+  if (n_samples > 0 && GramMatrix::bytes(n_samples) <= this->_gram_budget &&
+      (budget.max_kernel_evaluations == 0 ||
+       n_samples * (n_samples + 1) / 2 < budget.max_kernel_evaluations)) {
+    const auto deadline = budget.time_limit.count() > 0
+                              ? this->_deadline
+                              : std::chrono::steady_clock::time_point::max();
+    gram.reset(
+        new GramMatrix(this->_kernel, x, this->_gram_threads, deadline));
+    this->_kernel_evaluations += gram->evaluations();
+  }
+
+  if (gram && gram->complete()) {
+    logger << LogLevel::Info << "Precomputed the "
+           << GramMatrix::bytes(n_samples) << " bytes kernel matrix.";
+    // Lookups in the matrix are not kernel evaluations.
+    this->smo(GramEvaluator(*gram), y, n_samples);
+  } else {
+    gram.reset();
+    const RowEvaluator<KernelT> k(this->_kernel, x);
+    this->smo(CountingEvaluator<RowEvaluator<KernelT>>(
+                  k, this->_kernel_evaluations),
+              y, n_samples);
+  }
+
+  // Copy the support vectors out of the borrowed data.
+  this->store_support(y, n_features,
+                      [&x, n_features](const std::size_t idx, Float* out) {
+                        std::copy(x.row(idx), x.row(idx) + n_features, out);
+                      });
+}
+
+template <typename KernelT>
+void BasicSVM<KernelT>::fit(const utils::RowSource& x, const VectorView& y,
+                            const std::size_t memory_budget) {
+  ADO_TRACE_SCOPE("fit");
+  const std::size_t n_samples = x.rows();
+  const std::size_t n_features = x.cols();
+  if (y.size != n_samples) {
+    throw std::invalid_argument("The number of labels must match the samples.");
+  }
+
+  utils::RowCache cache(x, memory_budget);
+
+  logger << LogLevel::Info << "Fitting " << n_samples
+         << " samples out-of-core with a cache of " << cache.capacity()
+         << " rows for a maximum of " << this->_max_steps << " steps.";
+
+  this->start_budget();
+  const CachedRowEvaluator<KernelT> k(this->_kernel, cache);
+  this->smo(CountingEvaluator<CachedRowEvaluator<KernelT>>(
+                k, this->_kernel_evaluations),
+            y, n_samples);
+
+  logger << LogLevel::Info << "Row cache hits: " << cache.hits()
+         << ", misses: " << cache.misses() << ".";
+
+  this->store_support(y, n_features,
+                      [&x](const std::size_t idx, Float* out) {
+                        x.read_rows(idx, 1, out);
+                      });
+}
+
+template <typename KernelT>
+template <typename CopyRowT>
+void BasicSVM<KernelT>::store_support(const VectorView& y,
+                                      const std::size_t n_features,
+                                      const CopyRowT& copy_row) {
+  std::vector<std::size_t> support_idxs;
+  for (std::size_t idx = 0; idx < this->_alphas.size(); ++idx) {
+    if (this->_alphas(idx) != 0) support_idxs.push_back(idx);
+  }
+
+  const std::size_t n_support = support_idxs.size();
+  FloatArray x_support = xt::empty<Float>({n_support, n_features});
+  FloatArray y_support = xt::empty<Float>({n_support});
+  FloatArray alphas = xt::empty<Float>({n_support});
+  SizeArray support_indices = xt::empty<std::size_t>({n_support});
+  for (std::size_t sv = 0; sv < n_support; ++sv) {
+    const auto idx = support_idxs[sv];
+    copy_row(idx, x_support.data() + sv * n_features);
+    y_support(sv) = y[idx];
+    alphas(sv) = this->_alphas(idx);
+    support_indices(sv) = idx;
+  }
+  this->_support_indices = std::move(support_indices);
+  this->_y_support = std::move(y_support);
+  this->_alphas = std::move(alphas);
+  this->pack_support(x_support);
+}
+
+template <typename KernelT>
+FloatArray BasicSVM<KernelT>::decision_function(const FloatArray& x) const {
+  FloatArray predictions = xt::zeros<Float>({x.shape(0)});
+  this->decision_function(make_view(x), predictions.data());
+  return predictions;
+}
+
+template <typename KernelT>
+void BasicSVM<KernelT>::decision_function(const MatrixView& x,
+                                          Float* out) const {
+  ADO_TRACE_SCOPE("decision_function");
+  const std::size_t n_samples = x.rows;
+  const std::size_t n_support = this->_packed.n_support();
+
+  if (n_support == 0) {
+    std::fill(out, out + n_samples, -this->_b);
+    return;
+  }
+
+  if (x.cols != this->_packed.n_features()) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+
+  for (std::size_t idx = 0; idx < n_samples; ++idx) {
+    out[idx] = this->_packed.evaluate(this->_kernel, x.row(idx)) - this->_b;
+  }
+}
+
+template <typename KernelT>
+template <typename EvaluatorT>
+void BasicSVM<KernelT>::smo(const EvaluatorT& k, const VectorView& y,
+                            const std::size_t n_samples) {
+  this->_alphas = xt::zeros<Float>({n_samples});
+  this->_errors = xt::zeros<Float>({n_samples});
+  this->_b = 0.0;
+  this->_engine.seed(this->_seed);
+  this->_iterations = 0;
+
+  std::size_t num_changed = 0;
+  bool examine_all = true;
+  std::size_t remaining_steps = this->_max_steps;
+
+  while ((num_changed > 0 || examine_all) && (remaining_steps > 0) &&
+         !this->budget_exhausted()) {
+    --remaining_steps;
+
+    logger << LogLevel::Debug << "Remaining steps: " << remaining_steps;
+
+    num_changed = 0;
+    if (examine_all) {
+      for (std::size_t idx = 0; idx < n_samples; ++idx) {
+        if (this->budget_exhausted()) break;
+        num_changed += this->examine_example(k, idx, y);
+      }
+    } else {
+      const auto condition = ((this->_alphas < this->_tol) ||
+                              (this->_alphas > (this->_C - this->_tol)));
+      const SizeArray filtered_indexes =
+          xt::flatten_indices(xt::where(condition));
+
+      for (std::size_t idx : filtered_indexes) {
+        if (this->budget_exhausted()) break;
+        num_changed += this->examine_example(k, idx, y);
+      }
+    }
+    this->_iterations += num_changed;
+
+    if (examine_all)
+      examine_all = false;
+    else if (num_changed == 0)
+      examine_all = true;
+  }
+
+  if (this->_stopped_early) {
+    logger << LogLevel::Info << "Training budget exhausted after "
+           << this->_kernel_evaluations
+           << " kernel evaluations, keeping the current solution.";
+  }
+}
+
+template <typename KernelT>
+template <typename EvaluatorT>
+Float BasicSVM<KernelT>::eval(const EvaluatorT& k, const VectorView& y,
+                              const std::size_t i) const {
+  Float w_x = 0.0;
+  for (std::size_t idx = 0; idx < this->_alphas.size(); ++idx) {
+    const auto alpha = this->_alphas(idx);
+    if (alpha != 0) {
+      w_x += alpha * y[idx] * k(idx, i);
+    }
+  }
+  return w_x - this->_b;
+}
+
+template <typename KernelT>
+template <typename EvaluatorT>
+std::int8_t BasicSVM<KernelT>::examine_example(const EvaluatorT& k,
+                                               const std::size_t i2,
+                                               const VectorView& y) {
+  ADO_TRACE_SCOPE("examine_example");
+  const auto y2 = y[i2];
+  const auto alph2 = this->_alphas(i2);
+
+  auto e2 = this->_errors(i2);
+
+  if ((alph2 < this->_tol) || alph2 > (this->_C - this->_tol)) {
+    e2 = this->eval(k, y, i2) - y2;
+  }
+
+  auto r2 = e2 * y2;
+  if ((r2 < -this->_tol && alph2 < this->_C) ||
+      (r2 > this->_tol && alph2 > 0)) {
+    const auto condition = ((this->_alphas < this->_tol) ||
+                            (this->_alphas > (this->_C - this->_tol)));
+    SizeArray filtered_indexes = xt::flatten_indices(xt::where(condition));
+
+    if (filtered_indexes.size() > 0) {
+      const auto i1 = xt::argmax(this->_errors);
+      if (this->take_step(k, i1(0), i2, y, y2, alph2, e2)) {
+        return 1;
+      }
+    }
+
+    if (filtered_indexes.size() > 0) {
+      xt::random::shuffle(filtered_indexes, this->_engine);
+      for (auto idx : filtered_indexes) {
+        if (this->budget_exhausted()) return 0;
+        if (this->take_step(k, idx, i2, y, y2, alph2, e2)) {
+          return 1;
+        }
+      }
+    }
+
+    SizeArray all_indexes = xt::arange<std::size_t>(0, this->_alphas.size());
+    xt::random::shuffle(all_indexes, this->_engine);
+    for (auto idx : all_indexes) {
+      if (this->budget_exhausted()) return 0;
+      if (this->take_step(k, idx, i2, y, y2, alph2, e2)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename KernelT>
+template <typename EvaluatorT>
+std::int8_t BasicSVM<KernelT>::take_step(const EvaluatorT& k,
+                                         const std::size_t i1,
+                                         const std::size_t i2,
+                                         const VectorView& y, const Float& y2,
+                                         const Float& alph2, const Float& e2) {
+  ADO_TRACE_SCOPE("take_step");
+  if (i1 == i2) return 0;
+
+  Float alph1 = this->_alphas(i1);
+  Float y1 = y[i1];
+
+  Float e1 = this->_errors(i1);
+  if ((alph1 < this->_tol) || (alph1 > (this->_C - this->_tol))) {
+    e1 = this->eval(k, y, i1) - y1;
+  }
+
+  auto s = y1 * y2;
+
+  Float L = 0;
+  Float H = 0;
+
+  if (y1 != y2) {
+    L = std::max(0.0, alph2 - alph1);
+    H = std::min(this->_C, this->_C + alph2 - alph1);
+  } else {
+    L = std::max(0.0, alph2 + alph1 - this->_C);
+    H = std::min(this->_C, alph2 + alph1);
+  }
+
+  if (L == H) return 0;
+
+  const auto k11 = k(i1, i1);
+  const auto k12 = k(i1, i2);
+  const auto k22 = k(i2, i2);
+  const auto eta = k11 + k22 - 2 * k12;
+
+  Float a2 = 0.0;
+  if (eta > 0) {
+    a2 = clip_value(alph2 + y2 * (e1 - e2) / eta, H, L);
+  } else {
+    const auto Lobj =
+        this->compute_gamma(alph1, alph2, L, k11, k12, k22, s, y1, y2, e1, e2);
+    const auto Hobj =
+        this->compute_gamma(alph1, alph2, H, k11, k12, k22, s, y1, y2, e1, e2);
+    if (Lobj < (Hobj - this->_tol))
+      a2 = L;
+    else if (Lobj > (Hobj + this->_tol))
+      a2 = H;
+    else
+      a2 = alph2;
+  }
+
+  if (std::abs(a2 - alph2) < this->_tol * (a2 + alph2 + this->_tol)) {
+    return 0;
+  }
+
+  const auto a1 = alph1 + s * (alph2 - a2);
+  auto new_b =
+      this->compute_b(e1, e2, y1, a1, alph1, y2, a2, alph2, k11, k12, k22);
+  auto delta_b = new_b - this->_b;
+  this->_b = new_b;
+
+  // Error cache.
+  auto t1 = y1 * (a1 - alph1);
+  auto t2 = y2 * (a2 - alph2);
+
+  {
+    ADO_TRACE_SCOPE("error_cache_update");
+    for (std::size_t idx = 0; idx < this->_alphas.size(); ++idx) {
+      if ((this->_alphas(idx) > 0) && (this->_alphas(idx) < this->_C)) {
+        this->_errors(idx) += t1 * k(i1, idx) + t2 * k(i2, idx) - delta_b;
+      }
+    }
+  }
+
+  this->_errors(i1) = 0.0;
+  this->_errors(i2) = 0.0;
+
+  this->_alphas(i1) = a1;
+  this->_alphas(i2) = a2;
+
+  return 1;
+}
+
+template class BasicSVM<kernels::Polynomial>;
+template class BasicSVM<kernels::RBF>;
+template class BasicSVM<kernels::Sigmoid>;
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,349 @@
+#include "ado/core/cascade_svm.h"
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+using IndexSet = std::vector<std::size_t>;
+
+IndexSet merge(const IndexSet& a, const IndexSet& b) {
+  IndexSet merged;
+  merged.reserve(a.size() + b.size());
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(merged));
+  return merged;
+}
+
+ado::SizeArray to_array(const IndexSet& set) {
+  ado::SizeArray array = xt::empty<std::size_t>({set.size()});
+  std::copy(set.begin(), set.end(), array.begin());
+  return array;
+}
+
+void write_fully(const int fd, const char* data, std::size_t size) {
+  while (size > 0) {
+    const auto n = ::write(fd, data, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) throw std::runtime_error("Unable to write to the pipe.");
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+bool read_fully(const int fd, char* data, std::size_t size) {
+  while (size > 0) {
+    const auto n = ::read(fd, data, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+// Support vector sets travel through the pipes as a uint64 count followed by
+// the uint64 indexes.
+void write_set(const int fd, const IndexSet& set) {
+  const std::vector<std::uint64_t> buffer(set.begin(), set.end());
+  const std::uint64_t size = buffer.size();
+  write_fully(fd, reinterpret_cast<const char*>(&size), sizeof(size));
+  write_fully(fd, reinterpret_cast<const char*>(buffer.data()),
+              buffer.size() * sizeof(std::uint64_t));
+}
+
+bool read_set(const int fd, IndexSet& set) {
+  std::uint64_t size = 0;
+  if (!read_fully(fd, reinterpret_cast<char*>(&size), sizeof(size))) {
+    return false;
+  }
+  std::vector<std::uint64_t> buffer(size);
+  if (!read_fully(fd, reinterpret_cast<char*>(buffer.data()),
+                  buffer.size() * sizeof(std::uint64_t))) {
+    return false;
+  }
+  set.assign(buffer.begin(), buffer.end());
+  return true;
+}
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+using ado::utils::LogLevel;
+
+CascadeSVM::CascadeSVM(const Float C, const Float tol,
+                       std::unique_ptr<Kernel> kernel,
+                       const std::size_t max_steps, const std::size_t seed,
+                       const std::size_t n_partitions, const Workers workers,
+                       const std::size_t max_passes)
+    : _C(C),
+      _tol(tol),
+      _kernel(std::move(kernel)),
+      _max_steps(max_steps),
+      _seed(seed),
+      _n_partitions(n_partitions),
+      _workers(workers),
+      _max_passes(max_passes) {
+  if (this->_n_partitions == 0) {
+    throw std::invalid_argument("At least one partition is required.");
+  }
+}
+
+void CascadeSVM::fit(const FloatArray& x, const FloatArray& y) {
+  const FloatArray y_target = xt::flatten(y);
+  const std::size_t n_samples = x.shape(0);
+
+  // Random, sorted partitions of the samples.
+  IndexSet permutation(n_samples);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::mt19937 engine(this->_seed);
+  std::shuffle(permutation.begin(), permutation.end(), engine);
+
+  const auto n_partitions = std::max<std::size_t>(
+      1, std::min(this->_n_partitions, n_samples));
+  std::vector<IndexSet> partitions(n_partitions);
+  for (std::size_t p = 0; p < n_partitions; ++p) {
+    const auto first = permutation.begin() + p * n_samples / n_partitions;
+    const auto last = permutation.begin() + (p + 1) * n_samples / n_partitions;
+    partitions[p].assign(first, last);
+    std::sort(partitions[p].begin(), partitions[p].end());
+  }
+
+  logger << LogLevel::Info << "Cascade fitting " << n_samples << " samples in "
+         << n_partitions << " partitions for a maximum of "
+         << this->_max_passes << " passes.";
+
+  IndexSet feedback;
+  this->_converged = false;
+
+  for (std::size_t pass = 0; pass < this->_max_passes; ++pass) {
+    std::vector<IndexSet> layer;
+    for (const auto& partition : partitions) {
+      layer.push_back(merge(partition, feedback));
+    }
+
+    // Train and merge pairwise until a single set is left.
+    while (layer.size() > 1) {
+      const auto support_sets = this->run_layer(x, y_target, layer);
+      std::vector<IndexSet> next;
+      for (std::size_t i = 0; i < support_sets.size(); i += 2) {
+        next.push_back((i + 1 < support_sets.size())
+                           ? merge(support_sets[i], support_sets[i + 1])
+                           : support_sets[i]);
+      }
+      layer = std::move(next);
+    }
+
+    // Last layer, trained here since it becomes the final model.
+    const auto x_last = xt::view(x, xt::keep(to_array(layer[0])), xt::all());
+    const auto y_last = xt::view(y_target, xt::keep(to_array(layer[0])));
+    this->_model = this->make_svm();
+    this->_model.fit(x_last, y_last);
+
+    IndexSet support;
+    for (auto local : this->_model.support_indices()) {
+      support.push_back(layer[0][local]);
+    }
+
+    // Global KKT conditions: every sample outside of the support set must
+    // have a functional margin of at least 1.
+    const auto f = this->_model.decision_function(x);
+    std::size_t n_violations = 0;
+    for (std::size_t idx = 0; idx < n_samples; ++idx) {
+      if (!std::binary_search(support.begin(), support.end(), idx) &&
+          y_target(idx) * f(idx) < 1.0 - this->_tol) {
+        ++n_violations;
+      }
+    }
+
+    logger << LogLevel::Info << "Cascade pass " << pass << ": "
+           << support.size() << " support vectors, " << n_violations
+           << " KKT violations.";
+
+    if (n_violations == 0) {
+      this->_converged = true;
+      break;
+    }
+    if (support == feedback) {
+      break;
+    }
+    feedback = std::move(support);
+  }
+}
+
+FloatArray CascadeSVM::fit_predict(const FloatArray& x, const FloatArray& y) {
+  this->fit(x, y);
+  return this->predict(x);
+}
+
+FloatArray CascadeSVM::predict(const FloatArray& x) const {
+  return this->_model.predict(x);
+}
+
+FloatArray CascadeSVM::decision_function(const FloatArray& x) const {
+  return this->_model.decision_function(x);
+}
+
+SVM CascadeSVM::make_svm() const {
+  return SVM(this->_C, this->_tol, this->_kernel->clone(), this->_max_steps,
+             this->_seed);
+}
+
+CascadeSVM::IndexSet CascadeSVM::train(const FloatArray& x,
+                                       const FloatArray& y,
+                                       const IndexSet& subset,
+                                       const std::size_t n_workers) const {
+  if (subset.empty()) {
+    return IndexSet();
+  }
+
+  const auto idxs = to_array(subset);
+  const FloatArray x_subset = xt::view(x, xt::keep(idxs), xt::all());
+  const FloatArray y_subset = xt::view(y, xt::keep(idxs));
+
+  // The workers of a layer already run in parallel, they share the kernel
+  // matrix budget and compute their matrix on a single thread.
+  auto svm = this->make_svm();
+  svm.set_gram_budget(svm.gram_budget() / n_workers);
+  svm.set_gram_threads(1);
+  svm.fit(x_subset, y_subset);
+
+  IndexSet support;
+  for (auto local : svm.support_indices()) {
+    support.push_back(subset[local]);
+  }
+  return support;
+}
+
+std::vector<CascadeSVM::IndexSet> CascadeSVM::run_layer(
+    const FloatArray& x, const FloatArray& y,
+    const std::vector<IndexSet>& subsets) const {
+  logger << LogLevel::Debug << "Cascade layer with " << subsets.size()
+         << " subsets.";
+
+  if (this->_workers == Workers::Processes) {
+    return this->run_processes(x, y, subsets);
+  }
+  return this->run_threads(x, y, subsets);
+}
+
+std::vector<CascadeSVM::IndexSet> CascadeSVM::run_threads(
+    const FloatArray& x, const FloatArray& y,
+    const std::vector<IndexSet>& subsets) const {
+  std::vector<IndexSet> results(subsets.size());
+  std::vector<std::exception_ptr> errors(subsets.size());
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 0; i < subsets.size(); ++i) {
+    threads.emplace_back([this, &x, &y, &subsets, &results, &errors, i]() {
+      try {
+        results[i] = this->train(x, y, subsets[i], subsets.size());
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+  return results;
+}
+
+std::vector<CascadeSVM::IndexSet> CascadeSVM::run_processes(
+    const FloatArray& x, const FloatArray& y,
+    const std::vector<IndexSet>& subsets) const {
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+
+  // Stop the workers already started when the next one cannot be.
+  const auto abort_workers = [&pids, &fds](const std::string& message) {
+    for (const int fd : fds) {
+      ::close(fd);
+    }
+    for (const pid_t pid : pids) {
+      ::kill(pid, SIGKILL);
+      while (::waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {
+      }
+    }
+    throw std::runtime_error(message);
+  };
+
+  for (const auto& subset : subsets) {
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) != 0) {
+      abort_workers("Unable to create a pipe.");
+    }
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+      ::close(pipe_fds[0]);
+      ::close(pipe_fds[1]);
+      abort_workers("Unable to fork a worker process.");
+    }
+
+    if (pid == 0) {
+      // Worker: the data is shared copy-on-write with the parent. Only the
+      // forking thread exists in the child, the logger mutex may have been
+      // held by another thread of the parent.
+      logger.set_enabled(false);
+      ::close(pipe_fds[0]);
+      int status = 0;
+      try {
+        write_set(pipe_fds[1], this->train(x, y, subset, subsets.size()));
+      } catch (...) {
+        status = 1;
+      }
+      ::close(pipe_fds[1]);
+      ::_exit(status);
+    }
+
+    ::close(pipe_fds[1]);
+    pids.push_back(pid);
+    fds.push_back(pipe_fds[0]);
+  }
+
+  std::vector<IndexSet> results(subsets.size());
+  bool failed = false;
+  for (std::size_t i = 0; i < pids.size(); ++i) {
+    failed |= !read_set(fds[i], results[i]);
+    ::close(fds[i]);
+
+    int status = 0;
+    while (::waitpid(pids[i], &status, 0) < 0 && errno == EINTR) {
+    }
+    failed |= !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  if (failed) {
+    throw std::runtime_error("A cascade worker process failed.");
+  }
+  return results;
+}
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,215 @@
+#include "ado/core/cpp_export.h"
+
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+
+// Values per line in the generated arrays.
+constexpr std::size_t kValuesPerLine = 3;
+
+// Integer polynomial degrees up to this one are expanded into products.
+constexpr Float kMaxExpandedDegree = 8.0;
+
+bool is_identifier(const std::string& name) {
+  if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+    return false;
+  }
+  for (const char c : name) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Double literal that parses back to the same value.
+ */
+std::string literal(const Float value) {
+  if (!std::isfinite(value)) {
+    throw std::invalid_argument("Cannot export a non-finite value.");
+  }
+  std::ostringstream stream;
+  stream.precision(std::numeric_limits<Float>::max_digits10);
+  stream << value;
+
+  auto text = stream.str();
+  if (text.find_first_of(".e") == std::string::npos) {
+    text += ".0";
+  }
+  return text;
+}
+
+void write_values(std::ofstream& output, const Float* values,
+                  const std::size_t n, const std::string& indent) {
+  for (std::size_t k = 0; k < n; ++k) {
+    output << ((k % kValuesPerLine == 0) ? indent : " ") << literal(values[k])
+           << ",";
+    if (k % kValuesPerLine == kValuesPerLine - 1 || k + 1 == n) {
+      output << "\n";
+    }
+  }
+}
+
+/**
+ * Statements accumulating the dot product or the squared distance of x and
+ * sv in `s`, unrolled over the features.
+ */
+void write_reduction(std::ofstream& output, const std::size_t n_features,
+                     const bool distance) {
+  output << "  double s = 0.0;\n";
+  for (std::size_t f = 0; f < n_features; ++f) {
+    if (distance) {
+      output << "  s += (x[" << f << "] - sv[" << f << "]) * (x[" << f
+             << "] - sv[" << f << "]);\n";
+    } else {
+      output << "  s += x[" << f << "] * sv[" << f << "];\n";
+    }
+  }
+}
+
+void write_kernel(std::ofstream& output, const ado::core::KernelParameters& k,
+                  const std::size_t n_features) {
+  using ado::core::KernelType;
+
+  output << "inline double kernel(const double* x, const double* sv) {\n";
+  switch (k.type) {
+    case KernelType::Polynomial: {
+      const Float degree = k.degree;
+      const bool expanded = degree == std::round(degree) && degree >= 0.0 &&
+                            degree <= kMaxExpandedDegree;
+      if (expanded && degree == 0.0) {
+        // Constant kernel, pow(t, 0) is 1 for any t: the arguments are
+        // unused.
+        output << "  static_cast<void>(x);\n  static_cast<void>(sv);\n"
+               << "  return 1.0;\n";
+        break;
+      }
+
+      write_reduction(output, n_features, false);
+      output << "  const double t = " << literal(k.gamma) << " * s + "
+             << literal(k.coeff) << ";\n";
+      if (expanded) {
+        output << "  return 1.0";
+        for (int d = 0; d < static_cast<int>(degree); ++d) {
+          output << " * t";
+        }
+        output << ";\n";
+      } else {
+        output << "  return std::pow(t, " << literal(degree) << ");\n";
+      }
+      break;
+    }
+    case KernelType::RBF:
+      write_reduction(output, n_features, true);
+      output << "  return std::exp(" << literal(-k.gamma) << " * s);\n";
+      break;
+    case KernelType::Sigmoid:
+    default:
+      write_reduction(output, n_features, false);
+      output << "  return std::tanh(" << literal(k.gamma) << " * s + "
+             << literal(k.coeff) << ");\n";
+      break;
+  }
+  output << "}\n\n";
+}
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+using ado::utils::LogLevel;
+
+void export_cpp_header(const SVM& svm, const std::string& filepath,
+                       const std::string& name) {
+  if (!is_identifier(name)) {
+    throw std::invalid_argument("Not a valid C++ identifier: " + name);
+  }
+  const auto kernel = kernel_parameters(svm.kernel());
+  std::ofstream output(filepath);
+  if (!output) {
+    throw std::runtime_error("Unable to open file " + filepath);
+  }
+
+  const std::size_t n_support = svm.alphas().size();
+  const std::size_t n_features = svm.n_features();
+
+  std::string guard = name;
+  for (auto& c : guard) {
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  guard = "ADO_GENERATED_" + guard + "_H";
+
+  output << "// Generated by ado::core::export_cpp_header, do not edit.\n"
+         << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+         << "#include <cmath>\n#include <cstddef>\n\n"
+         << "namespace " << name << " {\n\n"
+         << "constexpr std::size_t kSupportVectors = " << n_support << ";\n"
+         << "constexpr std::size_t kFeatures = " << n_features << ";\n"
+         << "constexpr double kBias = " << literal(svm.bias()) << ";\n\n";
+
+  if (n_support > 0) {
+    write_kernel(output, kernel, n_features);
+  }
+
+  output << "/**\n * Un-thresholded predicted value of the kFeatures values of "
+            "x.\n */\n"
+         << "inline double decision_function(const double* x) {\n";
+  if (n_support > 0) {
+    // Function-local statics of an inline function are a single entity in
+    // every translation unit, unlike namespace scope constexpr arrays which
+    // have internal linkage. Zero-sized arrays are ill-formed, they are only
+    // emitted when non-empty.
+    const FloatArray support = svm.support_vectors();
+    output << "  alignas(64) static constexpr double kSupport[" << n_support
+           << "][" << n_features << "] = {\n";
+    for (std::size_t i = 0; i < n_support; ++i) {
+      output << "      {\n";
+      write_values(output, support.data() + i * n_features, n_features,
+                   "          ");
+      output << "      },\n";
+    }
+    output << "  };\n";
+
+    const FloatArray coefficients = svm.alphas() * svm.support_labels();
+    output << "  alignas(64) static constexpr double kCoefficients["
+           << n_support << "] = {\n";
+    write_values(output, coefficients.data(), n_support, "      ");
+    output << "  };\n\n"
+           << "  double f = -kBias;\n"
+           << "  for (std::size_t i = 0; i < kSupportVectors; ++i) {\n"
+           << "    f += kCoefficients[i] * kernel(x, kSupport[i]);\n"
+           << "  }\n";
+  } else {
+    output << "  (void)x;\n"
+           << "  double f = -kBias;\n";
+  }
+  output << "  return f;\n}\n\n"
+         << "/**\n * Predicted label [-1, 1] of the kFeatures values of x.\n"
+            " */\n"
+         << "inline double predict(const double* x) {\n"
+         << "  const double f = decision_function(x);\n"
+         << "  return (f < 0.0) ? -1.0 : ((f > 0.0) ? 1.0 : f);\n}\n\n"
+         << "}  // namespace " << name << "\n\n"
+         << "#endif  // " << guard << "\n";
+
+  if (!output) {
+    throw std::runtime_error("Unable to write file " + filepath);
+  }
+  logger << LogLevel::Info << "Exported " << n_support
+         << " support vectors to " << filepath << ".";
+}
+
+}  // namespace core
+}  // namespace ado
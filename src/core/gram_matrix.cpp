@@ -0,0 +1,94 @@
+#include "ado/core/gram_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "ado/core/kernel_functions.h"
+#include "ado/utils/trace.h"
+
+namespace ado {
+namespace core {
+
+constexpr std::size_t GramMatrix::kBlockRows;
+
+std::size_t GramMatrix::bytes(const std::size_t n_samples) {
+  const std::size_t max = std::numeric_limits<std::size_t>::max();
+  if (n_samples == 0) return 0;
+  if (n_samples > max / n_samples) return max;
+  // Halved before the product, which cannot overflow when n^2 fits.
+  const std::size_t n_values = n_samples / 2 * (n_samples + 1) +
+                               (n_samples % 2) * ((n_samples + 1) / 2);
+  if (n_values > max / sizeof(Float)) return max;
+  return n_values * sizeof(Float);
+}
+
+template <typename KernelT>
+GramMatrix::GramMatrix(const KernelT& kernel, const MatrixView& x,
+                       const std::size_t n_threads,
+                       const std::chrono::steady_clock::time_point deadline)
+    : _n_samples(x.rows) {
+  ADO_TRACE_SCOPE("gram_matrix");
+  const std::size_t n = x.rows;
+  const std::size_t n_features = x.cols;
+  // Not value-initialized, every value is written once below.
+  this->_values.reset(new Float[n * (n + 1) / 2]);
+
+  // Rows of blocks are taken dynamically, the lower ones being the longest.
+  const std::size_t n_blocks = (n + kBlockRows - 1) / kBlockRows;
+  const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+  std::atomic<std::size_t> next_block(0);
+  std::atomic<std::size_t> evaluations(0);
+  const auto compute_blocks = [&]() {
+    for (std::size_t bi = next_block++; bi < n_blocks; bi = next_block++) {
+      if (timed && std::chrono::steady_clock::now() >= deadline) {
+        // The other workers stop at their next row of blocks.
+        next_block = n_blocks;
+        break;
+      }
+      const std::size_t i_begin = bi * kBlockRows;
+      const std::size_t i_end = std::min(n, i_begin + kBlockRows);
+      for (std::size_t bj = 0; bj <= bi; ++bj) {
+        const std::size_t j_begin = bj * kBlockRows;
+        const std::size_t j_end = std::min(i_end, j_begin + kBlockRows);
+        for (std::size_t i = i_begin; i < i_end; ++i) {
+          Float* row = this->_values.get() + i * (i + 1) / 2;
+          for (std::size_t j = j_begin; j < std::min(j_end, i + 1); ++j) {
+            row[j] = kernel(x.row(i), x.row(j), n_features);
+          }
+        }
+      }
+      // Rows i_begin to i_end - 1 hold i + 1 values each.
+      evaluations += (i_end - i_begin) * (i_begin + i_end + 1) / 2;
+    }
+  };
+
+  const std::size_t n_workers = std::min<std::size_t>(
+      n_blocks, n_threads > 0 ? n_threads
+                             : std::max<std::size_t>(
+                                   1, std::thread::hardware_concurrency()));
+  std::vector<std::thread> workers;
+  for (std::size_t w = 1; w < n_workers; ++w) {
+    workers.emplace_back(compute_blocks);
+  }
+  compute_blocks();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  this->_evaluations = evaluations.load();
+}
+
+template GramMatrix::GramMatrix(const kernels::Polynomial&, const MatrixView&,
+                                const std::size_t,
+                                const std::chrono::steady_clock::time_point);
+template GramMatrix::GramMatrix(const kernels::RBF&, const MatrixView&,
+                                const std::size_t,
+                                const std::chrono::steady_clock::time_point);
+template GramMatrix::GramMatrix(const kernels::Sigmoid&, const MatrixView&,
+                                const std::size_t,
+                                const std::chrono::steady_clock::time_point);
+
+}  // namespace core
+}  // namespace ado
@@ -1,10 +1,48 @@
 #include "ado/core/kernel.h"
 
+#include <stdexcept>
 #include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xview.hpp>
 
 namespace ado {
 namespace core {
 
+// Kernel.
+
+FloatArray Kernel::gram(const FloatArray& x1, const FloatArray& x2) const {
+  FloatArray k = xt::empty<Float>({x1.shape(0), x2.shape(0)});
+  for (std::size_t i = 0; i < x1.shape(0); ++i) {
+    const FloatArray row = xt::view(x1, i, xt::all());
+    xt::view(k, i, xt::all()) = (*this)(row, x2);
+  }
+  return k;
+}
+
+std::unique_ptr<Kernel> Kernel::clone() const {
+  throw std::invalid_argument("This kernel cannot be copied.");
+}
+
+KernelParameters kernel_parameters(const Kernel& kernel) {
+  KernelParameters parameters;
+  if (const auto* k = dynamic_cast<const KernelPolynomial*>(&kernel)) {
+    parameters.type = KernelType::Polynomial;
+    parameters.degree = k->degree();
+    parameters.gamma = k->gamma();
+    parameters.coeff = k->coeff();
+  } else if (const auto* k = dynamic_cast<const KernelRBF*>(&kernel)) {
+    parameters.type = KernelType::RBF;
+    parameters.gamma = k->gamma();
+  } else if (const auto* k = dynamic_cast<const KernelSigmoid*>(&kernel)) {
+    parameters.type = KernelType::Sigmoid;
+    parameters.gamma = k->gamma();
+    parameters.coeff = k->coeff();
+  } else {
+    throw std::invalid_argument(
+        "Unsupported kernel, expected a polynomial, RBF or sigmoid kernel.");
+  }
+  return parameters;
+}
+
 // Polynomial Kernel.
 
 KernelPolynomial::KernelPolynomial(const Float degree, const Float gamma,
@@ -20,6 +58,16 @@ FloatArray KernelPolynomial::operator()(const FloatArray& x1,
   return xt::pow(this->_gamma * s + this->_coeff, this->_degree);
 }
 
+FloatArray KernelPolynomial::gram(const FloatArray& x1,
+                                  const FloatArray& x2) const {
+  auto s = xt::linalg::dot(x1, xt::transpose(x2));
+  return xt::pow(this->_gamma * s + this->_coeff, this->_degree);
+}
+
+std::unique_ptr<Kernel> KernelPolynomial::clone() const {
+  return std::make_unique<KernelPolynomial>(*this);
+}
+
 // RBF Kernel.
 
 KernelRBF::KernelRBF(const Float gamma)
@@ -31,6 +79,21 @@ FloatArray KernelRBF::operator()(const FloatArray& x1,
   return xt::exp(-this->_gamma * distance);
 }
 
+FloatArray KernelRBF::gram(const FloatArray& x1, const FloatArray& x2) const {
+  // ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a.b, so the whole matrix is a single
+  // GEMM plus two broadcasts.
+  FloatArray n1 = xt::sum(x1 * x1, {1});
+  FloatArray n2 = xt::sum(x2 * x2, {1});
+  FloatArray distance = xt::view(n1, xt::all(), xt::newaxis()) +
+                        xt::view(n2, xt::newaxis(), xt::all()) -
+                        2.0 * xt::linalg::dot(x1, xt::transpose(x2));
+  return xt::exp(-this->_gamma * xt::maximum(distance, 0.0));
+}
+
+std::unique_ptr<Kernel> KernelRBF::clone() const {
+  return std::make_unique<KernelRBF>(*this);
+}
+
 // Sigmoid Kernel.
 
 KernelSigmoid::KernelSigmoid(const Float gamma, const Float coeff)
@@ -42,5 +105,15 @@ FloatArray KernelSigmoid::operator()(const FloatArray& x1,
   return xt::tanh(this->_gamma * s + this->_coeff);
 }
 
+FloatArray KernelSigmoid::gram(const FloatArray& x1,
+                               const FloatArray& x2) const {
+  auto s = xt::linalg::dot(x1, xt::transpose(x2));
+  return xt::tanh(this->_gamma * s + this->_coeff);
+}
+
+std::unique_ptr<Kernel> KernelSigmoid::clone() const {
+  return std::make_unique<KernelSigmoid>(*this);
+}
+
 }  // namespace core
 }  // namespace ado
\ No newline at end of file
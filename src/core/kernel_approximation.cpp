@@ -0,0 +1,110 @@
+#include "ado/core/kernel_approximation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+
+// Eigenvalues below this threshold are treated as zero when inverting the
+// landmark Gram matrix: their components are dropped (pseudo-inverse) rather
+// than amplified by up to 1/sqrt(threshold).
+constexpr Float kEigenvalueFloor = 1e-12;
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+using ado::utils::LogLevel;
+
+FloatArray KernelApproximation::fit_transform(const FloatArray& x) {
+  this->fit(x);
+  return this->transform(x);
+}
+
+// Nystroem.
+
+Nystroem::Nystroem(std::unique_ptr<Kernel> kernel,
+                   const std::size_t n_components, const std::size_t seed)
+    : _kernel(std::move(kernel)), _n_components(n_components), _seed(seed) {}
+
+void Nystroem::fit(const FloatArray& x) {
+  const std::size_t n_samples = x.shape(0);
+  const std::size_t n_landmarks = std::min(this->_n_components, n_samples);
+
+  if (n_landmarks < this->_n_components) {
+    logger << LogLevel::Info << "Nystroem: only " << n_samples
+           << " samples available, using " << n_landmarks << " landmarks.";
+  }
+
+  xt::random::default_engine_type engine(this->_seed);
+  const auto permutation =
+      xt::random::permutation<std::size_t>(n_samples, engine);
+  const SizeArray landmark_idxs =
+      xt::view(permutation, xt::range(0, n_landmarks));
+  this->_landmarks = xt::view(x, xt::keep(landmark_idxs), xt::all());
+
+  // K_mm = U diag(s) U^T, the map is K_xm U diag(1/sqrt(s)) U^T.
+  const FloatArray k_mm =
+      this->_kernel->gram(this->_landmarks, this->_landmarks);
+  const auto eigen = xt::linalg::eigh(k_mm);
+  const auto& s = std::get<0>(eigen);
+  const auto& u = std::get<1>(eigen);
+
+  const FloatArray inv_sqrt_s =
+      xt::where(s > kEigenvalueFloor,
+                1.0 / xt::sqrt(xt::maximum(s, kEigenvalueFloor)), 0.0);
+  this->_normalization = xt::linalg::dot(
+      u * xt::view(inv_sqrt_s, xt::newaxis(), xt::all()), xt::transpose(u));
+}
+
+FloatArray Nystroem::transform(const FloatArray& x) const {
+  if (this->_landmarks.size() == 0) {
+    throw std::runtime_error("Nystroem must be fitted before transform.");
+  }
+  return xt::linalg::dot(this->_kernel->gram(x, this->_landmarks),
+                         this->_normalization);
+}
+
+// Random Fourier Features.
+
+RandomFourierFeatures::RandomFourierFeatures(const Float gamma,
+                                             const std::size_t n_components,
+                                             const std::size_t seed)
+    : _gamma(gamma), _n_components(n_components), _seed(seed) {}
+
+void RandomFourierFeatures::fit(const FloatArray& x) {
+  const std::size_t n_features = x.shape(1);
+
+  // The Fourier transform of exp(-gamma ||d||^2) is a gaussian with variance
+  // 2 gamma.
+  xt::random::default_engine_type engine(this->_seed);
+  this->_weights =
+      xt::random::randn<Float>({n_features, this->_n_components}, 0.0,
+                               std::sqrt(2.0 * this->_gamma), engine);
+  this->_offsets = xt::random::rand<Float>({this->_n_components}, 0.0,
+                                           2.0 * M_PI, engine);
+}
+
+FloatArray RandomFourierFeatures::transform(const FloatArray& x) const {
+  if (this->_weights.size() == 0) {
+    throw std::runtime_error(
+        "RandomFourierFeatures must be fitted before transform.");
+  }
+  const Float scale = std::sqrt(2.0 / this->_n_components);
+  return scale * xt::cos(xt::linalg::dot(x, this->_weights) +
+                         xt::view(this->_offsets, xt::newaxis(), xt::all()));
+}
+
+}  // namespace core
+}  // namespace ado
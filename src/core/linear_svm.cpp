@@ -0,0 +1,205 @@
+#include "ado/core/linear_svm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+using ado::FloatArray;
+using ado::utils::LogLevel;
+
+constexpr Float kInf = std::numeric_limits<Float>::infinity();
+
+// Value of the constant feature appended to every sample to learn the bias.
+constexpr Float kBiasFeature = 1.0;
+
+inline Float dot(const Float* a, const Float* b, const std::size_t n) {
+  Float s = 0.0;
+  for (std::size_t k = 0; k < n; ++k) s += a[k] * b[k];
+  return s;
+}
+
+FloatArray flatten_target(const FloatArray& y, const std::size_t n_samples) {
+  FloatArray y_target = xt::flatten(y);
+  if (y_target.size() != n_samples) {
+    throw std::invalid_argument("The number of labels must match the samples.");
+  }
+  if (!xt::all(xt::equal(y_target, 1.0) || xt::equal(y_target, -1.0))) {
+    throw std::invalid_argument("The labels must have binary values [-1, 1].");
+  }
+  return y_target;
+}
+
+/**
+ * Dual coordinate descent with shrinking (Algorithm 3 in Hsieh et al.).
+ * `row(i)` must return a pointer to the M contiguous features of sample i.
+ */
+template <typename RowAccessor>
+std::size_t dual_coordinate_descent(
+    const RowAccessor& row, const std::size_t n_samples,
+    const std::size_t n_features, const Float* y, const Float C,
+    const Float tol, const std::size_t max_steps, const std::size_t seed,
+    Float* w, Float& b) {
+  std::vector<Float> alphas(n_samples, 0.0);
+  std::vector<Float> q_diag(n_samples);
+  std::vector<std::size_t> index(n_samples);
+  std::iota(index.begin(), index.end(), 0);
+
+  for (std::size_t i = 0; i < n_samples; ++i) {
+    const Float* xi = row(i);
+    q_diag[i] = dot(xi, xi, n_features) + kBiasFeature * kBiasFeature;
+  }
+
+  xt::random::default_engine_type engine(seed);
+  Float pg_max_old = kInf;
+  Float pg_min_old = -kInf;
+  std::size_t active_size = n_samples;
+
+  std::size_t step = 0;
+  for (; step < max_steps; ++step) {
+    Float pg_max_new = -kInf;
+    Float pg_min_new = kInf;
+
+    std::shuffle(index.begin(), index.begin() + active_size, engine);
+
+    std::size_t s = 0;
+    while (s < active_size) {
+      const std::size_t i = index[s];
+      const Float yi = y[i];
+      const Float* xi = row(i);
+
+      const Float g = yi * (dot(w, xi, n_features) + b * kBiasFeature) - 1.0;
+
+      // Projected gradient, shrinking the variables stuck at a bound.
+      Float pg = 0.0;
+      if (alphas[i] == 0.0) {
+        if (g > pg_max_old) {
+          std::swap(index[s], index[--active_size]);
+          continue;
+        }
+        if (g < 0.0) pg = g;
+      } else if (alphas[i] == C) {
+        if (g < pg_min_old) {
+          std::swap(index[s], index[--active_size]);
+          continue;
+        }
+        if (g > 0.0) pg = g;
+      } else {
+        pg = g;
+      }
+
+      pg_max_new = std::max(pg_max_new, pg);
+      pg_min_new = std::min(pg_min_new, pg);
+
+      if (std::abs(pg) > 1e-12) {
+        const Float alpha_old = alphas[i];
+        alphas[i] = std::min(std::max(alpha_old - g / q_diag[i], 0.0), C);
+        const Float d = (alphas[i] - alpha_old) * yi;
+        for (std::size_t k = 0; k < n_features; ++k) w[k] += d * xi[k];
+        b += d * kBiasFeature;
+      }
+      ++s;
+    }
+
+    logger << LogLevel::Debug << "Step " << step << ", active samples "
+           << active_size << ", projected gradient gap "
+           << pg_max_new - pg_min_new;
+
+    if (pg_max_new - pg_min_new <= tol) {
+      if (active_size == n_samples) break;
+      // Converged on the active set, verify on the whole problem.
+      active_size = n_samples;
+      pg_max_old = kInf;
+      pg_min_old = -kInf;
+      continue;
+    }
+
+    pg_max_old = (pg_max_new <= 0.0) ? kInf : pg_max_new;
+    pg_min_old = (pg_min_new >= 0.0) ? -kInf : pg_min_new;
+  }
+  return step;
+}
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+LinearSVM::LinearSVM(const Float C, const Float tol,
+                     const std::size_t max_steps, const std::size_t seed)
+    : _C(C), _tol(tol), _max_steps(max_steps), _seed(seed) {}
+
+void LinearSVM::fit(const FloatArray& x, const FloatArray& y) {
+  const std::size_t n_samples = x.shape(0);
+  const std::size_t n_features = x.shape(1);
+  const FloatArray y_target = flatten_target(y, n_samples);
+
+  logger << LogLevel::Info << "Fitting " << n_samples << " samples with "
+         << n_features << " features for a maximum of " << this->_max_steps
+         << " steps.";
+
+  this->_weights = xt::zeros<Float>({n_features});
+  this->_b = 0.0;
+
+  // xarray storage is contiguous and row-major.
+  const Float* data = x.data();
+  const auto row = [data, n_features](const std::size_t i) {
+    return data + i * n_features;
+  };
+  const auto steps = dual_coordinate_descent(
+      row, n_samples, n_features, y_target.data(), this->_C, this->_tol,
+      this->_max_steps, this->_seed, this->_weights.data(), this->_b);
+
+  logger << LogLevel::Info << "Fitting completed in " << steps << " steps.";
+}
+
+void LinearSVM::fit(const utils::MappedMatrix& x, const FloatArray& y) {
+  const std::size_t n_samples = x.rows();
+  const std::size_t n_features = x.cols();
+  const FloatArray y_target = flatten_target(y, n_samples);
+
+  logger << LogLevel::Info << "Fitting " << n_samples
+         << " memory-mapped samples with " << n_features
+         << " features for a maximum of " << this->_max_steps << " steps.";
+
+  this->_weights = xt::zeros<Float>({n_features});
+  this->_b = 0.0;
+
+  const auto row = [&x](const std::size_t i) { return x.row(i); };
+  const auto steps = dual_coordinate_descent(
+      row, n_samples, n_features, y_target.data(), this->_C, this->_tol,
+      this->_max_steps, this->_seed, this->_weights.data(), this->_b);
+
+  logger << LogLevel::Info << "Fitting completed in " << steps << " steps.";
+}
+
+FloatArray LinearSVM::fit_predict(const FloatArray& x, const FloatArray& y) {
+  this->fit(x, y);
+  return this->predict(x);
+}
+
+FloatArray LinearSVM::predict(const FloatArray& x) const {
+  auto y_hat = this->decision_function(x);
+  filtration(y_hat, y_hat < 0) = -1;
+  filtration(y_hat, y_hat > 0) = 1;
+  return y_hat;
+}
+
+FloatArray LinearSVM::decision_function(const FloatArray& x) const {
+  return xt::linalg::dot(x, this->_weights) + this->_b;
+}
+
+}  // namespace core
+}  // namespace ado
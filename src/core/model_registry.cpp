@@ -0,0 +1,76 @@
+#include "ado/core/model_registry.h"
+
+#include <thread>
+
+namespace ado {
+namespace core {
+
+ModelRegistry::ModelRegistry() { this->_current.store(new Snapshot()); }
+
+ModelRegistry::~ModelRegistry() { delete this->_current.load(); }
+
+void ModelRegistry::publish(const std::string& name, ModelPtr model) {
+  std::lock_guard<std::mutex> lock(this->_writer);
+  auto* snapshot = new Snapshot(*this->_current.load());
+  snapshot->models[name] = std::move(model);
+  ++snapshot->version;
+  this->replace(snapshot);
+}
+
+bool ModelRegistry::remove(const std::string& name) {
+  std::lock_guard<std::mutex> lock(this->_writer);
+  if (this->_current.load()->models.count(name) == 0) {
+    return false;
+  }
+  auto* snapshot = new Snapshot(*this->_current.load());
+  snapshot->models.erase(name);
+  ++snapshot->version;
+  this->replace(snapshot);
+  return true;
+}
+
+ModelRegistry::ModelPtr ModelRegistry::get(const std::string& name) const {
+  auto& readers = this->enter();
+  const auto* snapshot = this->_current.load();
+  const auto it = snapshot->models.find(name);
+  ModelPtr model = (it != snapshot->models.end()) ? it->second : nullptr;
+  readers.fetch_sub(1);
+  return model;
+}
+
+std::uint64_t ModelRegistry::version() const {
+  auto& readers = this->enter();
+  const auto version = this->_current.load()->version;
+  readers.fetch_sub(1);
+  return version;
+}
+
+std::atomic<std::size_t>& ModelRegistry::enter() const {
+  // Register in the counter of the current epoch. If a writer advanced the
+  // epoch in the meantime it may have already checked that counter, retry in
+  // the new epoch.
+  for (;;) {
+    const auto epoch = this->_epoch.load();
+    auto& readers = this->_readers[epoch & 1].value;
+    readers.fetch_add(1);
+    if (this->_epoch.load() == epoch) {
+      return readers;
+    }
+    readers.fetch_sub(1);
+  }
+}
+
+void ModelRegistry::replace(Snapshot* snapshot) {
+  Snapshot* old = this->_current.exchange(snapshot);
+
+  // Readers entering the next epoch load the new snapshot, wait for the ones
+  // of the current epoch to leave.
+  const auto epoch = this->_epoch.fetch_add(1);
+  while (this->_readers[epoch & 1].value.load() != 0) {
+    std::this_thread::yield();
+  }
+  delete old;
+}
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,58 @@
+#include "ado/core/packed_support.h"
+
+#include <stdexcept>
+
+namespace ado {
+namespace core {
+
+constexpr std::size_t PackedSupport::kBlockSize;
+
+PackedSupport::PackedSupport(const FloatArray& x_support,
+                             const FloatArray& coefficients)
+    : _n_support(coefficients.size()) {
+  if (this->_n_support == 0) {
+    return;
+  }
+  const auto view = make_view(x_support);
+  if (view.rows != this->_n_support) {
+    throw std::invalid_argument("Inconsistent number of support vectors.");
+  }
+
+  this->_n_features = view.cols;
+  this->_n_blocks = (this->_n_support + kBlockSize - 1) / kBlockSize;
+  const std::size_t n_padded = this->_n_blocks * kBlockSize;
+
+  this->_vectors.assign(n_padded * this->_n_features, 0.0);
+  this->_coefficients.assign(n_padded, 0.0);
+
+  for (std::size_t i = 0; i < this->_n_support; ++i) {
+    const std::size_t block = i / kBlockSize;
+    const std::size_t lane = i % kBlockSize;
+    Float* dst = this->_vectors.data() + block * kBlockSize * this->_n_features;
+    const Float* row = view.row(i);
+
+    for (std::size_t f = 0; f < this->_n_features; ++f) {
+      dst[f * kBlockSize + lane] = row[f];
+    }
+    this->_coefficients[i] = coefficients(i);
+  }
+}
+
+FloatArray PackedSupport::unpack() const {
+  FloatArray x_support =
+      xt::empty<Float>({this->_n_support, this->_n_features});
+  for (std::size_t i = 0; i < this->_n_support; ++i) {
+    const std::size_t block = i / kBlockSize;
+    const std::size_t lane = i % kBlockSize;
+    const Float* src =
+        this->_vectors.data() + block * kBlockSize * this->_n_features;
+    Float* row = x_support.data() + i * this->_n_features;
+    for (std::size_t f = 0; f < this->_n_features; ++f) {
+      row[f] = src[f * kBlockSize + lane];
+    }
+  }
+  return x_support;
+}
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,197 @@
+#include "ado/core/quantized_svm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <xtensor/xindex_view.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+using ado::Float;
+using ado::utils::LogLevel;
+
+constexpr Float kInt8Max = 127.0;
+
+// Rows are zero-padded to a multiple of the SIMD block size.
+constexpr std::size_t kRowAlignment = 32;
+
+inline std::int8_t quantize(const Float value, const Float inv_scale) {
+  const auto q = std::round(value * inv_scale);
+  return static_cast<std::int8_t>(std::max(-kInt8Max, std::min(kInt8Max, q)));
+}
+
+/**
+ * int8 dot product accumulated in int32. `n` must be a multiple of 16.
+ */
+inline std::int32_t dot_int8(const std::int8_t* a, const std::int8_t* b,
+                             const std::size_t n) {
+#if defined(__AVX2__)
+  __m256i acc = _mm256_setzero_si256();
+  for (std::size_t k = 0; k < n; k += 16) {
+    const __m256i va = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k)));
+    const __m256i vb = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k)));
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+    acc = _mm256_dpwssd_epi32(acc, va, vb);
+#else
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+#endif
+  }
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+#else
+  std::int32_t acc = 0;
+  for (std::size_t k = 0; k < n; ++k) {
+    acc += static_cast<std::int32_t>(a[k]) * static_cast<std::int32_t>(b[k]);
+  }
+  return acc;
+#endif
+}
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+QuantizedSVM::QuantizedSVM(const SVM& svm)
+    : _b(svm.bias()) {
+  const auto kernel = kernel_parameters(svm.kernel());
+  this->_kernel_type = kernel.type;
+  this->_degree = kernel.degree;
+  this->_gamma = kernel.gamma;
+  this->_coeff = kernel.coeff;
+
+  const auto& x_support = svm.support_vectors();
+  this->_n_support = svm.alphas().size();
+  this->_n_features = (this->_n_support > 0) ? x_support.shape(1) : 0;
+  this->_row_size = (this->_n_features + kRowAlignment - 1) / kRowAlignment *
+                    kRowAlignment;
+
+  // Per-feature offsets and symmetric scales around them.
+  this->_offsets.assign(this->_n_features, 0.0);
+  this->_scales.assign(this->_n_features, 1.0);
+  for (std::size_t f = 0; f < this->_n_features; ++f) {
+    Float low = x_support(0, f);
+    Float high = low;
+    for (std::size_t i = 1; i < this->_n_support; ++i) {
+      low = std::min(low, x_support(i, f));
+      high = std::max(high, x_support(i, f));
+    }
+    this->_offsets[f] = 0.5 * (low + high);
+    if (high > low) this->_scales[f] = 0.5 * (high - low) / kInt8Max;
+    this->_offsets_norm2 += this->_offsets[f] * this->_offsets[f];
+  }
+
+  this->_support.assign(this->_n_support * this->_row_size, 0);
+  this->_support_norms2.assign(this->_n_support, 0.0);
+  this->_support_offsets.assign(this->_n_support, 0.0);
+  this->_coefficients.assign(this->_n_support, 0.0);
+  for (std::size_t i = 0; i < this->_n_support; ++i) {
+    auto* row = this->_support.data() + i * this->_row_size;
+    for (std::size_t f = 0; f < this->_n_features; ++f) {
+      row[f] = quantize(x_support(i, f) - this->_offsets[f],
+                        1.0 / this->_scales[f]);
+      const Float dequantized = row[f] * this->_scales[f];
+      this->_support_norms2[i] += dequantized * dequantized;
+      this->_support_offsets[i] += dequantized * this->_offsets[f];
+    }
+    this->_coefficients[i] = svm.alphas()(i) * svm.support_labels()(i);
+  }
+
+  logger << LogLevel::Info << "Quantized " << this->_n_support
+         << " support vectors to " << this->storage_size() << " bytes.";
+}
+
+FloatArray QuantizedSVM::predict(const FloatArray& x) const {
+  auto y_hat = this->decision_function(x);
+  filtration(y_hat, y_hat < 0) = -1;
+  filtration(y_hat, y_hat > 0) = 1;
+  return y_hat;
+}
+
+FloatArray QuantizedSVM::decision_function(const FloatArray& x) const {
+  const std::size_t n_samples = x.shape(0);
+  FloatArray predictions = xt::zeros<Float>({n_samples});
+  if (this->_n_support > 0 && x.shape(1) != this->_n_features) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+  if (this->_n_support == 0) {
+    predictions.fill(-this->_b);
+    return predictions;
+  }
+
+  std::vector<std::int8_t> query(this->_row_size, 0);
+  std::vector<Float> scaled(this->_n_features);
+
+  for (std::size_t idx = 0; idx < n_samples; ++idx) {
+    const Float* xi = x.data() + idx * this->_n_features;
+
+    // Center the query, fold the support vector scales into it, then
+    // quantize it.
+    Float x_norm2 = 0.0;
+    Float x_offsets = 0.0;
+    Float max_abs = 0.0;
+    for (std::size_t f = 0; f < this->_n_features; ++f) {
+      const Float centered = xi[f] - this->_offsets[f];
+      x_norm2 += centered * centered;
+      x_offsets += centered * this->_offsets[f];
+      scaled[f] = centered * this->_scales[f];
+      max_abs = std::max(max_abs, std::abs(scaled[f]));
+    }
+    const Float query_scale = (max_abs > 0.0) ? max_abs / kInt8Max : 1.0;
+    for (std::size_t f = 0; f < this->_n_features; ++f) {
+      query[f] = quantize(scaled[f], 1.0 / query_scale);
+    }
+
+    Float value = -this->_b;
+    for (std::size_t i = 0; i < this->_n_support; ++i) {
+      const auto* row = this->_support.data() + i * this->_row_size;
+      const Float dot =
+          query_scale * dot_int8(query.data(), row, this->_row_size);
+      value += this->_coefficients[i] *
+               this->kernel_value(dot, x_norm2, x_offsets, i);
+    }
+    predictions(idx) = value;
+  }
+  return predictions;
+}
+
+Float QuantizedSVM::max_error(const SVM& reference, const FloatArray& x) const {
+  const auto error = xt::amax(
+      xt::abs(this->decision_function(x) - reference.decision_function(x)))();
+
+  logger << LogLevel::Info << "Quantized decision function max error "
+         << error << " over " << x.shape(0) << " samples.";
+  return error;
+}
+
+Float QuantizedSVM::kernel_value(const Float dot, const Float x_norm2,
+                                 const Float x_offsets,
+                                 const std::size_t sv) const {
+  if (this->_kernel_type == KernelType::RBF) {
+    const auto distance = x_norm2 + this->_support_norms2[sv] - 2.0 * dot;
+    return std::exp(-this->_gamma * std::max(distance, 0.0));
+  }
+
+  // x.sv = (x' + o).(sv' + o).
+  const Float full_dot =
+      dot + x_offsets + this->_support_offsets[sv] + this->_offsets_norm2;
+  if (this->_kernel_type == KernelType::Polynomial) {
+    return std::pow(this->_gamma * full_dot + this->_coeff, this->_degree);
+  }
+  return std::tanh(this->_gamma * full_dot + this->_coeff);
+}
+
+}  // namespace core
+}  // namespace ado
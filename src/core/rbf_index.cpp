@@ -0,0 +1,205 @@
+#include "ado/core/rbf_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <xtensor/xindex_view.hpp>
+
+#include "ado/core/kernel_functions.h"
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+}  // namespace
+
+namespace ado {
+namespace core {
+
+using ado::utils::LogLevel;
+
+RBFIndex::RBFIndex(const SVM& svm, const Float tolerance,
+                   const std::size_t leaf_size)
+    : _b(svm.bias()), _tolerance(tolerance), _leaf_size(leaf_size) {
+  const auto kernel = kernel_parameters(svm.kernel());
+  if (kernel.type != KernelType::RBF) {
+    throw std::invalid_argument("RBFIndex requires an RBF kernel.");
+  }
+  if (tolerance < 0.0) {
+    throw std::invalid_argument("The tolerance must be non-negative.");
+  }
+  if (leaf_size == 0) {
+    throw std::invalid_argument("The leaf size must be strictly positive.");
+  }
+  this->_gamma = kernel.gamma;
+
+  const auto& x_support = svm.support_vectors();
+  const std::size_t n_support = svm.alphas().size();
+  if (n_support == 0) {
+    return;
+  }
+  this->_n_features = x_support.shape(1);
+
+  // Coefficients in the original order while building, in tree order after.
+  this->_coefficients.resize(n_support);
+  for (std::size_t i = 0; i < n_support; ++i) {
+    this->_coefficients[i] = svm.alphas()(i) * svm.support_labels()(i);
+    this->_total += std::abs(this->_coefficients[i]);
+  }
+
+  std::vector<std::size_t> order(n_support);
+  std::iota(order.begin(), order.end(), 0);
+  this->build(x_support, order, 0, n_support);
+
+  std::vector<Float> coefficients(n_support);
+  this->_support.resize(n_support * this->_n_features);
+  for (std::size_t i = 0; i < n_support; ++i) {
+    coefficients[i] = this->_coefficients[order[i]];
+    std::copy(x_support.data() + order[i] * this->_n_features,
+              x_support.data() + (order[i] + 1) * this->_n_features,
+              this->_support.data() + i * this->_n_features);
+  }
+  this->_coefficients = std::move(coefficients);
+
+  logger << LogLevel::Info << "Indexed " << n_support
+         << " support vectors in " << this->_nodes.size()
+         << " nodes, tolerance " << this->_tolerance << ".";
+}
+
+FloatArray RBFIndex::predict(const FloatArray& x) const {
+  auto y_hat = this->decision_function(x);
+  filtration(y_hat, y_hat < 0) = -1;
+  filtration(y_hat, y_hat > 0) = 1;
+  return y_hat;
+}
+
+FloatArray RBFIndex::decision_function(const FloatArray& x) const {
+  FloatArray predictions = xt::empty<Float>({x.shape(0)});
+  this->decision_function(make_view(x), predictions.data());
+  return predictions;
+}
+
+void RBFIndex::decision_function(const MatrixView& x, Float* out,
+                                 Float* error_bounds,
+                                 std::size_t* n_evaluated) const {
+  if (!this->_nodes.empty() && x.cols != this->_n_features) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+
+  for (std::size_t idx = 0; idx < x.rows; ++idx) {
+    Float value = -this->_b;
+    Float error_bound = 0.0;
+    std::size_t evaluated = 0;
+    if (!this->_nodes.empty()) {
+      this->query(x.row(idx), 0, value, error_bound, evaluated);
+    }
+
+    out[idx] = value;
+    if (error_bounds != nullptr) error_bounds[idx] = error_bound;
+    if (n_evaluated != nullptr) n_evaluated[idx] = evaluated;
+  }
+}
+
+std::size_t RBFIndex::build(const FloatArray& x_support,
+                            std::vector<std::size_t>& order,
+                            const std::size_t begin, const std::size_t end) {
+  const std::size_t n_features = this->_n_features;
+  const std::size_t id = this->_nodes.size();
+  this->_nodes.emplace_back();
+  this->_centers.resize(this->_centers.size() + n_features, 0.0);
+
+  Node node;
+  node.begin = begin;
+  node.end = end;
+
+  std::vector<Float> center(n_features, 0.0);
+  std::vector<Float> lower(n_features, std::numeric_limits<Float>::max());
+  std::vector<Float> upper(n_features, std::numeric_limits<Float>::lowest());
+  for (std::size_t k = begin; k < end; ++k) {
+    const Float* row = x_support.data() + order[k] * n_features;
+    for (std::size_t f = 0; f < n_features; ++f) {
+      center[f] += row[f];
+      lower[f] = std::min(lower[f], row[f]);
+      upper[f] = std::max(upper[f], row[f]);
+    }
+    const Float c = this->_coefficients[order[k]];
+    (c > 0.0 ? node.positive : node.negative) += c;
+  }
+  for (auto& value : center) {
+    value /= static_cast<Float>(end - begin);
+  }
+  for (std::size_t k = begin; k < end; ++k) {
+    const Float* row = x_support.data() + order[k] * n_features;
+    node.radius =
+        std::max(node.radius, kernels::squared_distance(
+                                  center.data(), row, n_features));
+  }
+  node.radius = std::sqrt(node.radius);
+  std::copy(center.begin(), center.end(),
+            this->_centers.begin() + id * n_features);
+
+  if (end - begin > this->_leaf_size) {
+    // Median split along the dimension with the largest spread.
+    std::size_t split = 0;
+    for (std::size_t f = 1; f < n_features; ++f) {
+      if (upper[f] - lower[f] > upper[split] - lower[split]) split = f;
+    }
+    const std::size_t middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle,
+                     order.begin() + end,
+                     [&](const std::size_t a, const std::size_t b) {
+                       return x_support(a, split) < x_support(b, split);
+                     });
+
+    node.left = this->build(x_support, order, begin, middle);
+    node.right = this->build(x_support, order, middle, end);
+  }
+
+  this->_nodes[id] = node;
+  return id;
+}
+
+void RBFIndex::query(const Float* x, const std::size_t id, Float& value,
+                     Float& error_bound, std::size_t& n_evaluated) const {
+  const Node& node = this->_nodes[id];
+  const std::size_t n_features = this->_n_features;
+
+  // Bounds of the kernel values of the node from the distances to its ball.
+  const Float distance = std::sqrt(kernels::squared_distance(
+      x, this->_centers.data() + id * n_features, n_features));
+  const Float d_min = std::max(distance - node.radius, 0.0);
+  const Float d_max = distance + node.radius;
+  const Float k_max = std::exp(-this->_gamma * d_min * d_min);
+  const Float k_min = std::exp(-this->_gamma * d_max * d_max);
+
+  const Float lower = node.positive * k_min + node.negative * k_max;
+  const Float upper = node.positive * k_max + node.negative * k_min;
+  const Float half_width = 0.5 * (upper - lower);
+  const Float share =
+      (this->_total > 0.0)
+          ? this->_tolerance * (node.positive - node.negative) / this->_total
+          : 0.0;
+
+  if (half_width <= share) {
+    value += 0.5 * (lower + upper);
+    error_bound += half_width;
+    return;
+  }
+
+  if (node.left == 0) {
+    const kernels::RBF kernel{this->_gamma};
+    for (std::size_t i = node.begin; i < node.end; ++i) {
+      value += this->_coefficients[i] *
+               kernel(x, this->_support.data() + i * n_features, n_features);
+    }
+    n_evaluated += node.end - node.begin;
+    return;
+  }
+
+  this->query(x, node.left, value, error_bound, n_evaluated);
+  this->query(x, node.right, value, error_bound, n_evaluated);
+}
+
+}  // namespace core
+}  // namespace ado
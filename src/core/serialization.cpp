@@ -0,0 +1,157 @@
+#include "ado/core/serialization.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using ado::Float;
+
+constexpr char kMagic[8] = {'A', 'D', 'O', 'S', 'V', 'M', '0', '1'};
+
+template <typename T>
+void write_value(std::ofstream& output, const T& value) {
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(std::ifstream& input) {
+  T value;
+  input.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+void write_array(std::ofstream& output, const ado::FloatArray& array) {
+  // Make sure the payload is written in row-major order.
+  const xt::xarray<Float, xt::layout_type::row_major> row_major = array;
+  output.write(reinterpret_cast<const char*>(row_major.data()),
+               row_major.size() * sizeof(Float));
+}
+
+void read_array(std::ifstream& input, ado::FloatArray& array) {
+  input.read(reinterpret_cast<char*>(array.data()),
+             array.size() * sizeof(Float));
+}
+
+/**
+ * @brief Check the support set size read from the header against the rest of
+ * the file before allocating it, so that a corrupt file cannot request a huge
+ * or overflowing allocation.
+ */
+void check_payload(std::ifstream& input, const std::uint64_t n_support,
+                   const std::uint64_t n_features,
+                   const std::string& filepath) {
+  constexpr auto kMax = std::numeric_limits<std::uint64_t>::max();
+  // Each support vector is stored as n_features values, a label and an alpha.
+  if (n_features > kMax - 2 ||
+      (n_support > 0 && n_features + 2 > kMax / sizeof(Float) / n_support)) {
+    throw std::runtime_error("Invalid model file " + filepath);
+  }
+  const std::uint64_t payload = n_support * (n_features + 2) * sizeof(Float);
+
+  const auto position = input.tellg();
+  input.seekg(0, std::ios::end);
+  const auto end = input.tellg();
+  input.seekg(position);
+  if (position < 0 || end < position ||
+      static_cast<std::uint64_t>(end - position) < payload) {
+    throw std::runtime_error("Truncated model file " + filepath);
+  }
+}
+
+}  // namespace
+
+namespace ado {
+namespace core {
+
+void save_model(const SVM& svm, const std::string& filepath) {
+  const auto kernel = kernel_parameters(svm.kernel());
+  std::ofstream output(filepath, std::ios::binary);
+  if (!output) {
+    throw std::runtime_error("Unable to open file " + filepath);
+  }
+
+  const std::uint64_t n_support = svm.alphas().size();
+  const std::uint64_t n_features = svm.n_features();
+
+  output.write(kMagic, sizeof(kMagic));
+  write_value<std::uint64_t>(output, static_cast<std::uint64_t>(kernel.type));
+  write_value(output, kernel.degree);
+  write_value(output, kernel.gamma);
+  write_value(output, kernel.coeff);
+  write_value(output, svm.bias());
+  write_value(output, n_support);
+  write_value(output, n_features);
+  if (n_support > 0) {
+    write_array(output, svm.support_vectors());
+    write_array(output, svm.support_labels());
+    write_array(output, svm.alphas());
+  }
+
+  if (!output) {
+    throw std::runtime_error("Unable to write file " + filepath);
+  }
+}
+
+SVM load_model(const std::string& filepath) {
+  std::ifstream input(filepath, std::ios::binary);
+  if (!input) {
+    throw std::runtime_error("File does not exist !");
+  }
+
+  char magic[sizeof(kMagic)];
+  input.read(magic, sizeof(magic));
+  if (!input || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Not an ado model file: " + filepath);
+  }
+
+  const auto type = static_cast<KernelType>(read_value<std::uint64_t>(input));
+  const auto degree = read_value<Float>(input);
+  const auto gamma = read_value<Float>(input);
+  const auto coeff = read_value<Float>(input);
+  const auto b = read_value<Float>(input);
+  const auto n_support = read_value<std::uint64_t>(input);
+  const auto n_features = read_value<std::uint64_t>(input);
+  if (!input) {
+    throw std::runtime_error("Truncated model file " + filepath);
+  }
+  check_payload(input, n_support, n_features, filepath);
+
+  std::unique_ptr<Kernel> kernel;
+  switch (type) {
+    case KernelType::Polynomial:
+      kernel = std::make_unique<KernelPolynomial>(degree, gamma, coeff);
+      break;
+    case KernelType::RBF:
+      kernel = std::make_unique<KernelRBF>(gamma);
+      break;
+    case KernelType::Sigmoid:
+      kernel = std::make_unique<KernelSigmoid>(gamma, coeff);
+      break;
+    default:
+      throw std::runtime_error("Unknown kernel type in " + filepath);
+  }
+
+  FloatArray x_support = xt::empty<Float>({n_support, n_features});
+  FloatArray y_support = xt::empty<Float>({n_support});
+  FloatArray alphas = xt::empty<Float>({n_support});
+  read_array(input, x_support);
+  read_array(input, y_support);
+  read_array(input, alphas);
+  if (!input) {
+    throw std::runtime_error("Truncated model file " + filepath);
+  }
+
+  // The training hyper-parameters are not needed for inference.
+  SVM svm(1.0, 1e-3, std::move(kernel), 1000, 16);
+  svm.set_support(std::move(x_support), std::move(y_support),
+                  std::move(alphas), b);
+  return svm;
+}
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,158 @@
+#include "ado/core/sign_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace ado {
+namespace core {
+
+SignPredictor::SignPredictor(const SVM& svm, const std::size_t check_interval)
+    : _b(svm.bias()), _check_interval(check_interval) {
+  if (check_interval == 0) {
+    throw std::invalid_argument("The check interval must be positive.");
+  }
+
+  const auto kernel = kernel_parameters(svm.kernel());
+  this->_type = kernel.type;
+  if (this->_type == KernelType::Polynomial) {
+    this->_polynomial = {kernel.degree, kernel.gamma, kernel.coeff};
+  } else if (this->_type == KernelType::RBF) {
+    this->_rbf = {kernel.gamma};
+  } else {
+    this->_sigmoid = {kernel.gamma, kernel.coeff};
+  }
+
+  const std::size_t n_support = svm.alphas().size();
+  this->_positive_suffix.assign(n_support + 1, 0.0);
+  this->_negative_suffix.assign(n_support + 1, 0.0);
+  this->_absolute_suffix.assign(n_support + 1, 0.0);
+  this->_norm_suffix.assign(n_support + 1, 0.0);
+  if (n_support == 0) {
+    return;
+  }
+
+  const auto& x_support = svm.support_vectors();
+  this->_n_features = x_support.shape(1);
+
+  std::vector<Float> coefficients(n_support);
+  for (std::size_t i = 0; i < n_support; ++i) {
+    coefficients[i] = svm.alphas()(i) * svm.support_labels()(i);
+  }
+  std::vector<std::size_t> order(n_support);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&coefficients](const std::size_t a, const std::size_t b) {
+                     return std::abs(coefficients[a]) >
+                            std::abs(coefficients[b]);
+                   });
+
+  const std::size_t n_features = this->_n_features;
+  this->_support.resize(n_support * n_features);
+  this->_coefficients.resize(n_support);
+  for (std::size_t i = 0; i < n_support; ++i) {
+    const Float* row = x_support.data() + order[i] * n_features;
+    std::copy(row, row + n_features, this->_support.data() + i * n_features);
+    this->_coefficients[i] = coefficients[order[i]];
+  }
+
+  for (std::size_t i = n_support; i-- > 0;) {
+    const Float coefficient = this->_coefficients[i];
+    const Float* row = this->_support.data() + i * n_features;
+    const Float norm = std::sqrt(kernels::dot(row, row, n_features));
+    this->_positive_suffix[i] =
+        this->_positive_suffix[i + 1] + std::max<Float>(coefficient, 0.0);
+    this->_negative_suffix[i] =
+        this->_negative_suffix[i + 1] + std::min<Float>(coefficient, 0.0);
+    this->_absolute_suffix[i] =
+        this->_absolute_suffix[i + 1] + std::abs(coefficient);
+    this->_norm_suffix[i] = std::max(this->_norm_suffix[i + 1], norm);
+  }
+}
+
+template <typename KernelT, typename BoundT>
+Float SignPredictor::accumulate(const KernelT& kernel, const BoundT& remaining,
+                                const Float* x,
+                                std::size_t* terms_evaluated) const {
+  const std::size_t n_support = this->_coefficients.size();
+  const std::size_t n_features = this->_n_features;
+  Float partial = -this->_b;
+  Float low = 0.0;
+  Float high = 0.0;
+
+  std::size_t i = 0;
+  while (i < n_support) {
+    // f(x) lies in [partial + low, partial + high].
+    remaining(i, low, high);
+    if (partial + low > 0.0 || partial + high < 0.0) break;
+
+    const std::size_t end = std::min(n_support, i + this->_check_interval);
+    for (; i < end; ++i) {
+      partial += this->_coefficients[i] *
+                 kernel(x, this->_support.data() + i * n_features, n_features);
+    }
+  }
+
+  if (terms_evaluated != nullptr) *terms_evaluated = i;
+  if (partial > 0.0) return 1.0;
+  if (partial < 0.0) return -1.0;
+  return 0.0;
+}
+
+Float SignPredictor::predict_sign(const Float* x,
+                                  std::size_t* terms_evaluated) const {
+  if (this->_type == KernelType::RBF) {
+    // 0 < K <= 1, only the coefficients of each sign can move f that way.
+    const auto remaining = [this](const std::size_t i, Float& low,
+                                  Float& high) {
+      low = this->_negative_suffix[i];
+      high = this->_positive_suffix[i];
+    };
+    return this->accumulate(this->_rbf, remaining, x, terms_evaluated);
+  }
+
+  if (this->_type == KernelType::Sigmoid) {
+    const auto remaining = [this](const std::size_t i, Float& low,
+                                  Float& high) {
+      high = this->_absolute_suffix[i];
+      low = -high;
+    };
+    return this->accumulate(this->_sigmoid, remaining, x, terms_evaluated);
+  }
+
+  // |gamma <x, sv> + coeff| <= |gamma| |x| |sv| + |coeff| (Cauchy-Schwarz).
+  const kernels::Polynomial& polynomial = this->_polynomial;
+  const Float x_norm = std::sqrt(kernels::dot(x, x, this->_n_features));
+  const auto remaining = [this, &polynomial, x_norm](const std::size_t i,
+                                                     Float& low, Float& high) {
+    const Float k_max =
+        std::pow(std::abs(polynomial.gamma) * x_norm * this->_norm_suffix[i] +
+                     std::abs(polynomial.coeff),
+                 polynomial.degree);
+    high = this->_absolute_suffix[i] * k_max;
+    low = -high;
+  };
+  return this->accumulate(polynomial, remaining, x, terms_evaluated);
+}
+
+FloatArray SignPredictor::predict(const FloatArray& x) const {
+  FloatArray predictions = xt::empty<Float>({x.shape(0)});
+  this->predict(make_view(x), predictions.data());
+  return predictions;
+}
+
+void SignPredictor::predict(const MatrixView& x, Float* out,
+                            std::size_t* terms_evaluated) const {
+  if (this->n_support() > 0 && x.cols != this->_n_features) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+  for (std::size_t idx = 0; idx < x.rows; ++idx) {
+    out[idx] = this->predict_sign(
+        x.row(idx),
+        terms_evaluated != nullptr ? terms_evaluated + idx : nullptr);
+  }
+}
+
+}  // namespace core
+}  // namespace ado
@@ -0,0 +1,61 @@
+#include "ado/preprocessing/pipeline.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <xtensor/xindex_view.hpp>
+
+namespace ado {
+namespace preprocessing {
+
+Pipeline::Pipeline(std::unique_ptr<Scaler> scaler, core::SVM svm,
+                   const std::size_t chunk_rows)
+    : _scaler(std::move(scaler)),
+      _svm(std::move(svm)),
+      _chunk_rows(chunk_rows) {
+  if (!this->_scaler) {
+    throw std::invalid_argument("The pipeline requires a scaler.");
+  }
+  if (chunk_rows == 0) {
+    throw std::invalid_argument("The chunk size must be positive.");
+  }
+}
+
+void Pipeline::fit(const FloatArray& x, const FloatArray& y) {
+  this->_scaler->fit(x);
+  this->_svm.fit(this->_scaler->transform(x), y);
+}
+
+FloatArray Pipeline::fit_predict(const FloatArray& x, const FloatArray& y) {
+  this->fit(x, y);
+  return this->predict(x);
+}
+
+FloatArray Pipeline::predict(const FloatArray& x) const {
+  auto y_hat = this->decision_function(x);
+  filtration(y_hat, y_hat < 0) = -1;
+  filtration(y_hat, y_hat > 0) = 1;
+  return y_hat;
+}
+
+FloatArray Pipeline::decision_function(const FloatArray& x) const {
+  FloatArray predictions = xt::empty<Float>({x.shape(0)});
+  this->decision_function(make_view(x), predictions.data());
+  return predictions;
+}
+
+void Pipeline::decision_function(const MatrixView& x, Float* out) const {
+  // Per call buffer, so that concurrent calls do not share state.
+  std::vector<Float> chunk(std::min(this->_chunk_rows, x.rows) * x.cols);
+
+  for (std::size_t first = 0; first < x.rows; first += this->_chunk_rows) {
+    const std::size_t n_rows = std::min(this->_chunk_rows, x.rows - first);
+    const MatrixView rows{x.row(first), n_rows, x.cols, x.row_stride};
+    this->_scaler->transform(rows, chunk.data());
+    this->_svm.decision_function(
+        MatrixView{chunk.data(), n_rows, x.cols, x.cols}, out + first);
+  }
+}
+
+}  // namespace preprocessing
+}  // namespace ado
@@ -0,0 +1,228 @@
+#include "ado/preprocessing/scaler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using ado::Float;
+
+// Below this many values, a chunk is processed on the calling thread.
+constexpr std::size_t kParallelWork = std::size_t(1) << 18;
+
+// Minimum number of columns, or rows, given to a thread.
+constexpr std::size_t kMinGrain = 8;
+
+/**
+ * Run fn(begin, end) over [0, n) split in contiguous blocks between threads,
+ * when the chunk holds enough work.
+ */
+template <typename FunctionT>
+void parallel_for(const std::size_t n, const std::size_t work,
+                  const FunctionT& fn) {
+  const std::size_t hardware =
+      std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  const std::size_t n_threads =
+      (work < kParallelWork) ? 1 : std::min(hardware, n / kMinGrain);
+  if (n_threads <= 1) {
+    fn(0, n);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < n_threads; ++t) {
+    threads.emplace_back(fn, t * n / n_threads, (t + 1) * n / n_threads);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+namespace ado {
+namespace preprocessing {
+
+void Scaler::fit(const FloatArray& x) { this->fit(make_view(x)); }
+
+void Scaler::fit(const MatrixView& x) {
+  this->reset();
+  this->partial_fit(x);
+}
+
+FloatArray Scaler::transform(const FloatArray& x) const {
+  const auto view = make_view(x);
+  FloatArray result = xt::empty<Float>({view.rows, view.cols});
+  this->transform(view, result.data());
+  return result;
+}
+
+void Scaler::transform_inplace(FloatArray& x) const {
+  this->transform(make_view(x), x.data());
+}
+
+void Scaler::transform(const MatrixView& x, Float* out) const {
+  const std::size_t n_features = this->_scale.size();
+  if (n_features == 0) {
+    throw std::runtime_error("The scaler is not fitted.");
+  }
+  if (x.cols != n_features) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+
+  const Float* scale = this->_scale.data();
+  const Float* offset = this->_offset.data();
+  parallel_for(x.rows, x.rows * n_features,
+               [&x, out, scale, offset, n_features](const std::size_t begin,
+                                                    const std::size_t end) {
+                 for (std::size_t r = begin; r < end; ++r) {
+                   const Float* row = x.row(r);
+                   Float* dst = out + r * n_features;
+                   for (std::size_t f = 0; f < n_features; ++f) {
+                     dst[f] = row[f] * scale[f] + offset[f];
+                   }
+                 }
+               });
+}
+
+FloatArray Scaler::fit_transform(const FloatArray& x) {
+  this->fit(x);
+  return this->transform(x);
+}
+
+bool Scaler::check_features(const std::size_t n_features) {
+  if (this->_scale.empty()) {
+    if (n_features == 0) {
+      throw std::invalid_argument("Expected at least one feature.");
+    }
+    this->_scale.assign(n_features, 1.0);
+    this->_offset.assign(n_features, 0.0);
+    return true;
+  }
+  if (n_features != this->_scale.size()) {
+    throw std::invalid_argument("Unexpected number of features.");
+  }
+  return false;
+}
+
+MinMaxScaler::MinMaxScaler(const Float min, const Float max)
+    : _range_min(min), _range_max(max) {
+  if (min >= max) {
+    throw std::invalid_argument("The feature range must be increasing.");
+  }
+}
+
+void MinMaxScaler::partial_fit(const MatrixView& x) {
+  if (x.rows == 0) return;
+  const std::size_t n_features = x.cols;
+  if (this->check_features(n_features)) {
+    this->_min.assign(n_features, std::numeric_limits<Float>::infinity());
+    this->_max.assign(n_features, -std::numeric_limits<Float>::infinity());
+  }
+
+  Float* min = this->_min.data();
+  Float* max = this->_max.data();
+  parallel_for(n_features, x.rows * n_features,
+               [&x, min, max](const std::size_t begin, const std::size_t end) {
+                 for (std::size_t r = 0; r < x.rows; ++r) {
+                   const Float* row = x.row(r);
+                   for (std::size_t f = begin; f < end; ++f) {
+                     min[f] = std::min(min[f], row[f]);
+                     max[f] = std::max(max[f], row[f]);
+                   }
+                 }
+               });
+
+  const Float range = this->_range_max - this->_range_min;
+  for (std::size_t f = 0; f < n_features; ++f) {
+    // Constant features are mapped to the lower bound of the range.
+    const Float data_range = max[f] - min[f];
+    this->_scale[f] = range / ((data_range > 0.0) ? data_range : 1.0);
+    this->_offset[f] = this->_range_min - min[f] * this->_scale[f];
+  }
+}
+
+void MinMaxScaler::reset() {
+  this->_scale.clear();
+  this->_offset.clear();
+  this->_min.clear();
+  this->_max.clear();
+}
+
+std::unique_ptr<Scaler> MinMaxScaler::clone() const {
+  return std::make_unique<MinMaxScaler>(*this);
+}
+
+void StandardScaler::partial_fit(const MatrixView& x) {
+  if (x.rows == 0) return;
+  const std::size_t n_features = x.cols;
+  if (this->check_features(n_features)) {
+    this->_count = 0;
+    this->_mean.assign(n_features, 0.0);
+    this->_m2.assign(n_features, 0.0);
+  }
+
+  // Single pass over the chunk: sums of the deviations from its first row,
+  // and of their squares.
+  std::vector<Float> s1(n_features, 0.0);
+  std::vector<Float> s2(n_features, 0.0);
+  const Float* shift = x.row(0);
+  Float* sum = s1.data();
+  Float* sum_squares = s2.data();
+  parallel_for(n_features, x.rows * n_features,
+               [&x, shift, sum, sum_squares](const std::size_t begin,
+                                             const std::size_t end) {
+                 for (std::size_t r = 0; r < x.rows; ++r) {
+                   const Float* row = x.row(r);
+                   for (std::size_t f = begin; f < end; ++f) {
+                     const Float d = row[f] - shift[f];
+                     sum[f] += d;
+                     sum_squares[f] += d * d;
+                   }
+                 }
+               });
+
+  // Merge the chunk statistics into the running ones.
+  const Float n_chunk = static_cast<Float>(x.rows);
+  const Float n_seen = static_cast<Float>(this->_count);
+  const Float n_total = n_seen + n_chunk;
+  for (std::size_t f = 0; f < n_features; ++f) {
+    const Float chunk_mean = shift[f] + sum[f] / n_chunk;
+    const Float chunk_m2 =
+        std::max(0.0, sum_squares[f] - sum[f] * sum[f] / n_chunk);
+    const Float delta = chunk_mean - this->_mean[f];
+    this->_mean[f] += delta * n_chunk / n_total;
+    this->_m2[f] += chunk_m2 + delta * delta * n_seen * n_chunk / n_total;
+
+    const Float deviation = std::sqrt(this->_m2[f] / n_total);
+    this->_scale[f] = (deviation > 0.0) ? 1.0 / deviation : 1.0;
+    this->_offset[f] = -this->_mean[f] * this->_scale[f];
+  }
+  this->_count += x.rows;
+}
+
+void StandardScaler::reset() {
+  this->_scale.clear();
+  this->_offset.clear();
+  this->_count = 0;
+  this->_mean.clear();
+  this->_m2.clear();
+}
+
+std::unique_ptr<Scaler> StandardScaler::clone() const {
+  return std::make_unique<StandardScaler>(*this);
+}
+
+std::vector<Float> StandardScaler::variance() const {
+  std::vector<Float> variance(this->_m2.size(), 0.0);
+  for (std::size_t f = 0; f < variance.size(); ++f) {
+    variance[f] = this->_m2[f] / std::max<std::size_t>(this->_count, 1);
+  }
+  return variance;
+}
+
+}  // namespace preprocessing
+}  // namespace ado
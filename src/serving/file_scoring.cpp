@@ -0,0 +1,268 @@
+#include "ado/serving/file_scoring.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ado/utils/bounded_queue.h"
+#include "ado/utils/logger.h"
+#include "ado/utils/trace.h"
+
+namespace ado {
+namespace serving {
+
+using ado::utils::LogLevel;
+
+namespace {
+
+auto& logger = ado::utils::Logger::get();
+
+struct Chunk {
+  std::size_t index = 0;
+  std::size_t n_rows = 0;
+  std::size_t n_features = 0;
+  std::vector<Float> values;
+  std::vector<Float> scores;
+};
+
+using ChunkQueue = utils::BoundedQueue<std::unique_ptr<Chunk>>;
+
+/**
+ * @brief Queues between the stages, and the first error of any stage.
+ */
+struct PipelineState {
+  explicit PipelineState(const std::size_t n_buffers)
+      : free(n_buffers), parsed(n_buffers), scored(n_buffers) {}
+
+  // Closing every queue unblocks and stops all the stages.
+  void fail(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(this->error_mutex);
+      if (!this->error) this->error = e;
+    }
+    this->free.close();
+    this->parsed.close();
+    this->scored.close();
+  }
+
+  ChunkQueue free;
+  ChunkQueue parsed;
+  ChunkQueue scored;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+/**
+ * @brief Append the values of a delimited line, return their number.
+ */
+std::size_t parse_row(const std::string& line, const char delimiter,
+                      std::vector<Float>& values) {
+  const char* begin = line.c_str();
+  std::size_t count = 0;
+  while (true) {
+    char* end = nullptr;
+    const Float value = std::strtod(begin, &end);
+    if (end == begin) {
+      throw std::runtime_error("Invalid value in line: " + line);
+    }
+    values.push_back(value);
+    ++count;
+
+    while (*end == ' ' || *end == '\t' || *end == '\r') ++end;
+    if (*end == '\0') return count;
+    if (*end != delimiter) {
+      throw std::runtime_error("Invalid value in line: " + line);
+    }
+    begin = end + 1;
+  }
+}
+
+bool is_blank(const std::string& line) {
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+void read_chunks(std::istream& input, const FileScoringOptions& options,
+                 PipelineState& state) {
+  std::string line;
+  std::size_t n_chunks = 0;
+  std::size_t n_features = 0;
+  std::unique_ptr<Chunk> chunk;
+
+  while (std::getline(input, line)) {
+    if (is_blank(line)) continue;
+    if (!chunk) {
+      if (!state.free.pop(chunk)) return;
+      chunk->index = n_chunks++;
+      chunk->n_rows = 0;
+      chunk->values.clear();
+    }
+
+    const std::size_t count = parse_row(line, options.delimiter, chunk->values);
+    if (n_features == 0) {
+      n_features = count;
+    } else if (count != n_features) {
+      throw std::runtime_error("Inconsistent number of features in line: " +
+                               line);
+    }
+    chunk->n_features = n_features;
+
+    if (++chunk->n_rows == options.chunk_rows) {
+      if (!state.parsed.push(std::move(chunk))) return;
+      chunk.reset();
+    }
+  }
+  if (input.bad()) {
+    throw std::runtime_error("Error while reading the input file.");
+  }
+  if (chunk) state.parsed.push(std::move(chunk));
+  state.parsed.close();
+}
+
+void score_chunks(const core::SVM& svm, const FileScoringOptions& options,
+                  PipelineState& state) {
+  std::unique_ptr<Chunk> chunk;
+  while (state.parsed.pop(chunk)) {
+    ADO_TRACE_SCOPE("score_chunk");
+    chunk->scores.resize(chunk->n_rows);
+    const MatrixView x{chunk->values.data(), chunk->n_rows, chunk->n_features,
+                       chunk->n_features};
+    if (options.decision_values) {
+      svm.decision_function(x, chunk->scores.data());
+    } else {
+      svm.predict(x, chunk->scores.data());
+    }
+    if (!state.scored.push(std::move(chunk))) return;
+  }
+}
+
+std::size_t write_chunks(std::ostream& output, PipelineState& state) {
+  // Chunks scored out of order wait here until their predecessors are written.
+  std::map<std::size_t, std::unique_ptr<Chunk>> pending;
+  std::size_t next = 0;
+  std::size_t n_rows = 0;
+  std::string text;
+  char buffer[32];
+
+  std::unique_ptr<Chunk> chunk;
+  while (state.scored.pop(chunk)) {
+    const std::size_t index = chunk->index;
+    pending.emplace(index, std::move(chunk));
+
+    for (auto it = pending.find(next); it != pending.end();
+         it = pending.find(next)) {
+      ADO_TRACE_SCOPE("write_chunk");
+      text.clear();
+      for (const Float score : it->second->scores) {
+        const int size =
+            std::snprintf(buffer, sizeof(buffer), "%.*g\n",
+                          std::numeric_limits<Float>::max_digits10, score);
+        text.append(buffer, size);
+      }
+      output.write(text.data(), text.size());
+      if (!output) {
+        throw std::runtime_error("Error while writing the output file.");
+      }
+
+      n_rows += it->second->n_rows;
+      state.free.push(std::move(it->second));
+      pending.erase(it);
+      ++next;
+    }
+  }
+  return n_rows;
+}
+
+}  // namespace
+
+std::size_t predict_file(const core::SVM& svm, const std::string& input_path,
+                         const std::string& output_path,
+                         const FileScoringOptions& options) {
+  if (options.chunk_rows == 0 || options.n_buffers == 0 ||
+      options.n_scorers == 0) {
+    throw std::invalid_argument(
+        "The chunk size, buffers and scorers must be positive.");
+  }
+
+  std::ifstream input(input_path);
+  if (!input) {
+    throw std::runtime_error("Unable to open file " + input_path);
+  }
+  std::ofstream output(output_path);
+  if (!output) {
+    throw std::runtime_error("Unable to open file " + output_path);
+  }
+
+  PipelineState state(options.n_buffers);
+  for (std::size_t i = 0; i < options.n_buffers; ++i) {
+    state.free.push(std::make_unique<Chunk>());
+  }
+
+  std::thread reader([&input, &options, &state]() {
+    try {
+      read_chunks(input, options, state);
+    } catch (...) {
+      state.fail(std::current_exception());
+    }
+  });
+
+  // The last scorer to finish tells the writer that no chunk is left.
+  std::atomic<std::size_t> running_scorers(options.n_scorers);
+  std::vector<std::thread> scorers;
+  for (std::size_t i = 0; i < options.n_scorers; ++i) {
+    scorers.emplace_back([&svm, &options, &state, &running_scorers]() {
+      try {
+        score_chunks(svm, options, state);
+      } catch (...) {
+        state.fail(std::current_exception());
+      }
+      if (running_scorers.fetch_sub(1) == 1) state.scored.close();
+    });
+  }
+
+  std::size_t n_rows = 0;
+  std::thread writer([&output, &state, &n_rows]() {
+    try {
+      n_rows = write_chunks(output, state);
+      output.flush();
+      if (!output) {
+        throw std::runtime_error("Error while writing the output file.");
+      }
+    } catch (...) {
+      state.fail(std::current_exception());
+    }
+  });
+
+  reader.join();
+  for (auto& scorer : scorers) {
+    scorer.join();
+  }
+  writer.join();
+
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+  logger << LogLevel::Info << "Scored " << n_rows << " rows from "
+         << input_path << ".";
+  return n_rows;
+}
+
+std::size_t predict_file(const core::SVM& svm, const std::string& input_path,
+                         const std::string& output_path,
+                         const std::size_t chunk_rows) {
+  FileScoringOptions options;
+  options.chunk_rows = chunk_rows;
+  return predict_file(svm, input_path, output_path, options);
+}
+
+}  // namespace serving
+}  // namespace ado
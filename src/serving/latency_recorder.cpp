@@ -0,0 +1,49 @@
+#include "ado/serving/latency_recorder.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ado {
+namespace serving {
+
+LatencyRecorder::LatencyRecorder(const std::size_t window) : _window(window) {
+  if (window == 0) {
+    throw std::invalid_argument("The latency window must be positive.");
+  }
+  this->_samples.reserve(window);
+}
+
+void LatencyRecorder::record(const std::chrono::nanoseconds latency) {
+  const Float microseconds = latency.count() / 1e3;
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_samples.size() < this->_window) {
+    this->_samples.push_back(microseconds);
+  } else {
+    this->_samples[this->_next] = microseconds;
+  }
+  this->_next = (this->_next + 1) % this->_window;
+  ++this->_count;
+}
+
+Float LatencyRecorder::percentile(const Float q) const {
+  std::vector<Float> samples;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    samples = this->_samples;
+  }
+  if (samples.empty()) return 0.0;
+
+  const auto rank = static_cast<std::size_t>(
+      std::max(0.0, std::min(1.0, q)) * (samples.size() - 1) + 0.5);
+  std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+  return samples[rank];
+}
+
+std::size_t LatencyRecorder::count() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_count;
+}
+
+}  // namespace serving
+}  // namespace ado
@@ -0,0 +1,119 @@
+#include "ado/serving/micro_batcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ado {
+namespace serving {
+
+MicroBatcher::MicroBatcher(const core::ModelRegistry& registry,
+                           std::string model, const BatchOptions& options)
+    : _registry(registry),
+      _model(std::move(model)),
+      _options(options),
+      _queue(options.queue_capacity) {
+  if (options.max_batch_rows == 0) {
+    throw std::invalid_argument("The batch size must be positive.");
+  }
+  this->_worker = std::thread(&MicroBatcher::run, this);
+}
+
+MicroBatcher::~MicroBatcher() {
+  this->_queue.close();
+  this->_worker.join();
+}
+
+std::future<std::vector<Float>> MicroBatcher::submit(
+    std::vector<Float> values, const std::size_t n_rows,
+    const std::size_t n_features) {
+  if (values.size() != n_rows * n_features) {
+    throw std::invalid_argument("Inconsistent request size.");
+  }
+
+  Pending pending;
+  pending.values = std::move(values);
+  pending.n_rows = n_rows;
+  pending.n_features = n_features;
+  auto result = pending.result.get_future();
+  if (!this->_queue.push(std::move(pending))) {
+    throw std::runtime_error("The batcher is shutting down.");
+  }
+  return result;
+}
+
+void MicroBatcher::run() {
+  std::vector<Pending> batch;
+  Pending next;
+  bool has_next = false;
+
+  for (;;) {
+    if (!has_next && !this->_queue.pop(next)) break;
+    has_next = false;
+
+    std::size_t n_rows = next.n_rows;
+    const std::size_t n_features = next.n_features;
+    batch.push_back(std::move(next));
+
+    const auto deadline =
+        std::chrono::steady_clock::now() + this->_options.max_delay;
+    while (n_rows < this->_options.max_batch_rows &&
+           this->_queue.pop_until(next, deadline)) {
+      if (next.n_features != n_features ||
+          n_rows + next.n_rows > this->_options.max_batch_rows) {
+        // Different shape or too many rows, it starts the next batch.
+        has_next = true;
+        break;
+      }
+      n_rows += next.n_rows;
+      batch.push_back(std::move(next));
+    }
+
+    this->score(batch);
+    batch.clear();
+  }
+}
+
+void MicroBatcher::score(std::vector<Pending>& batch) {
+  const std::size_t n_features = batch.front().n_features;
+  std::size_t n_rows = 0;
+  for (const auto& pending : batch) {
+    n_rows += pending.n_rows;
+  }
+
+  std::vector<std::vector<Float>> results;
+  try {
+    const auto model = this->_registry.get(this->_model);
+    if (!model) {
+      throw std::runtime_error("Unknown model " + this->_model);
+    }
+
+    FloatArray x = xt::empty<Float>({n_rows, n_features});
+    auto* dst = x.data();
+    for (const auto& pending : batch) {
+      dst = std::copy(pending.values.begin(), pending.values.end(), dst);
+    }
+
+    const FloatArray f = model->decision_function(x);
+    const auto* src = f.data();
+    for (const auto& pending : batch) {
+      results.emplace_back(src, src + pending.n_rows);
+      src += pending.n_rows;
+    }
+  } catch (...) {
+    for (auto& pending : batch) {
+      pending.result.set_exception(std::current_exception());
+    }
+    ++this->_batches;
+    return;
+  }
+
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    batch[i].result.set_value(std::move(results[i]));
+  }
+
+  ++this->_batches;
+  this->_rows += n_rows;
+}
+
+}  // namespace serving
+}  // namespace ado
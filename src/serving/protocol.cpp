@@ -0,0 +1,112 @@
+#include "ado/serving/protocol.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+
+namespace {
+
+// Returns the number of bytes read, less than size only at end of stream.
+std::size_t read_fully(const int fd, void* data, const std::size_t size) {
+  auto* bytes = static_cast<char*>(data);
+  std::size_t done = 0;
+  while (done < size) {
+    const auto n = ::read(fd, bytes + done, size - done);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) throw std::runtime_error("Unable to read from the socket.");
+    if (n == 0) break;
+    done += static_cast<std::size_t>(n);
+  }
+  return done;
+}
+
+void read_exactly(const int fd, void* data, const std::size_t size) {
+  if (read_fully(fd, data, size) != size) {
+    throw std::runtime_error("Truncated frame.");
+  }
+}
+
+void write_fully(const int fd, const void* data, const std::size_t size) {
+  const auto* bytes = static_cast<const char*>(data);
+  std::size_t done = 0;
+  while (done < size) {
+    // MSG_NOSIGNAL: a client gone away is an error, not a SIGPIPE.
+    const auto n = ::send(fd, bytes + done, size - done, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) throw std::runtime_error("Unable to write to the socket.");
+    done += static_cast<std::size_t>(n);
+  }
+}
+
+}  // namespace
+
+namespace ado {
+namespace serving {
+
+bool read_request(const int fd, Request& request) {
+  RequestHeader header;
+  const auto n = read_fully(fd, &header, sizeof(header));
+  if (n == 0) return false;
+  if (n != sizeof(header)) {
+    throw std::runtime_error("Truncated frame.");
+  }
+
+  const std::size_t n_values =
+      static_cast<std::size_t>(header.n_rows) * header.n_features;
+  if (header.name_size > kMaxNameSize || n_values > kMaxRequestValues) {
+    throw std::runtime_error("Request frame too large.");
+  }
+
+  request.model.resize(header.name_size);
+  read_exactly(fd, &request.model[0], header.name_size);
+  request.n_rows = header.n_rows;
+  request.n_features = header.n_features;
+  request.values.resize(n_values);
+  read_exactly(fd, request.values.data(), n_values * sizeof(Float));
+  return true;
+}
+
+void write_request(const int fd, const std::string& model,
+                   const Float* values, const std::size_t n_rows,
+                   const std::size_t n_features) {
+  const RequestHeader header{static_cast<std::uint32_t>(model.size()),
+                             static_cast<std::uint32_t>(n_rows),
+                             static_cast<std::uint32_t>(n_features)};
+  write_fully(fd, &header, sizeof(header));
+  write_fully(fd, model.data(), model.size());
+  write_fully(fd, values, n_rows * n_features * sizeof(Float));
+}
+
+void write_response(const int fd, const std::vector<Float>& values) {
+  const ResponseHeader header{static_cast<std::uint32_t>(Status::Ok),
+                              static_cast<std::uint32_t>(values.size())};
+  write_fully(fd, &header, sizeof(header));
+  write_fully(fd, values.data(), values.size() * sizeof(Float));
+}
+
+void write_error(const int fd, const std::string& message) {
+  const ResponseHeader header{static_cast<std::uint32_t>(Status::Error),
+                              static_cast<std::uint32_t>(message.size())};
+  write_fully(fd, &header, sizeof(header));
+  write_fully(fd, message.data(), message.size());
+}
+
+std::vector<Float> read_response(const int fd) {
+  ResponseHeader header;
+  read_exactly(fd, &header, sizeof(header));
+
+  if (header.status != static_cast<std::uint32_t>(Status::Ok)) {
+    std::string message(header.size, '\0');
+    read_exactly(fd, &message[0], message.size());
+    throw std::runtime_error(message);
+  }
+
+  std::vector<Float> values(header.size);
+  read_exactly(fd, values.data(), values.size() * sizeof(Float));
+  return values;
+}
+
+}  // namespace serving
+}  // namespace ado
@@ -0,0 +1,163 @@
+#include "ado/serving/server.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include "ado/serving/protocol.h"
+#include "ado/utils/logger.h"
+
+namespace {
+auto& logger = ado::utils::Logger::get();
+
+// Period at which the accept loop checks for a stop request.
+constexpr int kPollTimeoutMs = 100;
+}  // namespace
+
+namespace ado {
+namespace serving {
+
+using ado::utils::LogLevel;
+
+Server::Server(std::string socket_path, const core::ModelRegistry& registry,
+               const std::vector<std::string>& models,
+               const BatchOptions& options,
+               const std::chrono::seconds report_interval)
+    : _socket_path(std::move(socket_path)),
+      _report_interval(report_interval) {
+  for (const auto& model : models) {
+    this->_batchers.emplace(
+        model, std::make_unique<MicroBatcher>(registry, model, options));
+  }
+}
+
+Server::~Server() { this->stop(); }
+
+void Server::run() {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (this->_socket_path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("Socket path too long: " +
+                                this->_socket_path);
+  }
+  std::strcpy(address.sun_path, this->_socket_path.c_str());
+
+  const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    throw std::runtime_error("Unable to create the socket.");
+  }
+  ::unlink(this->_socket_path.c_str());
+  if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(listen_fd, SOMAXCONN) != 0) {
+    ::close(listen_fd);
+    throw std::runtime_error("Unable to listen on " + this->_socket_path);
+  }
+
+  logger << LogLevel::Info << "Serving " << this->_batchers.size()
+         << " models on " << this->_socket_path << ".";
+
+  auto last_report = std::chrono::steady_clock::now();
+  while (!this->_stopping.load()) {
+    pollfd listener{listen_fd, POLLIN, 0};
+    if (::poll(&listener, 1, kPollTimeoutMs) > 0) {
+      const int fd = ::accept(listen_fd, nullptr, nullptr);
+      if (fd >= 0) {
+        std::lock_guard<std::mutex> lock(this->_connections_mutex);
+        const auto id = this->_next_id++;
+        this->_connections.insert(fd);
+        this->_threads.emplace(id, std::thread(&Server::serve, this, id, fd));
+      }
+    }
+    this->reap();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_report >= this->_report_interval) {
+      this->report();
+      last_report = now;
+    }
+  }
+
+  ::close(listen_fd);
+  ::unlink(this->_socket_path.c_str());
+
+  // Unblock the connection threads waiting for a request.
+  {
+    std::lock_guard<std::mutex> lock(this->_connections_mutex);
+    for (const int fd : this->_connections) {
+      ::shutdown(fd, SHUT_RDWR);
+    }
+  }
+  for (auto& thread : this->_threads) {
+    thread.second.join();
+  }
+  this->_threads.clear();
+  this->_finished.clear();
+  this->report();
+}
+
+void Server::reap() {
+  // A connection thread is done once it is listed in _finished, it does not
+  // take the lock anymore.
+  std::lock_guard<std::mutex> lock(this->_connections_mutex);
+  for (const auto id : this->_finished) {
+    this->_threads[id].join();
+    this->_threads.erase(id);
+  }
+  this->_finished.clear();
+}
+
+void Server::stop() { this->_stopping.store(true); }
+
+void Server::report() const {
+  std::size_t batches = 0;
+  std::size_t rows = 0;
+  for (const auto& batcher : this->_batchers) {
+    batches += batcher.second->batches();
+    rows += batcher.second->rows();
+  }
+
+  logger << LogLevel::Info << this->_latency.count() << " requests, " << rows
+         << " rows in " << batches << " batches, latency p50 "
+         << this->_latency.percentile(0.5) << " us, p99 "
+         << this->_latency.percentile(0.99) << " us.";
+}
+
+void Server::serve(const std::size_t id, const int fd) {
+  Request request;
+  try {
+    while (!this->_stopping.load() && read_request(fd, request)) {
+      const auto start = std::chrono::steady_clock::now();
+
+      const auto batcher = this->_batchers.find(request.model);
+      if (batcher == this->_batchers.end()) {
+        write_error(fd, "Unknown model " + request.model);
+        continue;
+      }
+
+      try {
+        auto result = batcher->second->submit(
+            std::move(request.values), request.n_rows, request.n_features);
+        write_response(fd, result.get());
+      } catch (const std::exception& e) {
+        write_error(fd, e.what());
+      }
+      this->_latency.record(std::chrono::steady_clock::now() - start);
+    }
+  } catch (const std::exception& e) {
+    logger << LogLevel::Debug << "Connection closed: " << e.what();
+  }
+
+  std::lock_guard<std::mutex> lock(this->_connections_mutex);
+  this->_connections.erase(fd);
+  this->_finished.push_back(id);
+  ::close(fd);
+}
+
+}  // namespace serving
+}  // namespace ado
@@ -1,14 +1,19 @@
 #include "ado/utils/io.h"
 
+#include <cstdint>
 #include <fstream>
 #include <ostream>
+#include <stdexcept>
 #include <string>
 #include <xtensor/xcsv.hpp>
 
+#include "ado/utils/trace.h"
+
 namespace ado {
 namespace utils {
 
 FloatArray load_data(const std::string& filepath) {
+  ADO_TRACE_SCOPE("load_data");
   std::fstream input_file(filepath.c_str(), std::ios::in);
   if (!input_file) {
     throw std::runtime_error("File does not exist !");
@@ -23,5 +28,23 @@ void save_data(const FloatArray& data, const std::string& filepath) {
   xt::dump_csv(output_file, data);
 }
 
+void save_binary(const FloatArray& data, const std::string& filepath) {
+  if (data.dimension() != 2) {
+    throw std::invalid_argument("Only 2D arrays can be saved as binary.");
+  }
+  std::ofstream output_file(filepath, std::ios::binary);
+  if (!output_file) {
+    throw std::runtime_error("Unable to open file " + filepath);
+  }
+
+  const std::uint64_t header[2] = {data.shape(0), data.shape(1)};
+  output_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  // Make sure the payload is written in row-major order.
+  const xt::xarray<Float, xt::layout_type::row_major> row_major = data;
+  output_file.write(reinterpret_cast<const char*>(row_major.data()),
+                    row_major.size() * sizeof(Float));
+}
+
 }  // namespace utils
 }  // namespace ado
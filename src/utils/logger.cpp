@@ -19,6 +19,7 @@ void Logger::register_handler(std::unique_ptr<LoggerHandler> handler) {
 }
 
 void Logger::log(const std::string& message, const LogLevel level) {
+  if (!this->_enabled) return;
   this->_mutex.lock();
   for (auto handler = this->_handlers.begin(); handler != this->_handlers.end();
        ++handler) {
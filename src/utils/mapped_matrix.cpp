@@ -0,0 +1,78 @@
+#include "ado/utils/mapped_matrix.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace ado {
+namespace utils {
+
+MappedMatrix::MappedMatrix(const std::string& filepath) {
+  const int fd = ::open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("File does not exist !");
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < 2 * sizeof(std::uint64_t)) {
+    ::close(fd);
+    throw std::runtime_error("Invalid binary matrix file " + filepath);
+  }
+
+  this->_mapping_size = static_cast<std::size_t>(info.st_size);
+  this->_mapping =
+      ::mmap(nullptr, this->_mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (this->_mapping == MAP_FAILED) {
+    this->_mapping = nullptr;
+    throw std::runtime_error("Unable to map file " + filepath);
+  }
+
+  const auto header = static_cast<const std::uint64_t*>(this->_mapping);
+  this->_rows = static_cast<std::size_t>(header[0]);
+  this->_cols = static_cast<std::size_t>(header[1]);
+  this->_data = reinterpret_cast<const Float*>(header + 2);
+
+  // Checked before computing the expected size, which could wrap around.
+  const std::size_t header_size = 2 * sizeof(std::uint64_t);
+  if (this->_cols != 0 &&
+      this->_rows > (SIZE_MAX - header_size) / sizeof(Float) / this->_cols) {
+    ::munmap(this->_mapping, this->_mapping_size);
+    this->_mapping = nullptr;
+    throw std::runtime_error("Invalid binary matrix file " + filepath);
+  }
+
+  const auto expected =
+      header_size + this->_rows * this->_cols * sizeof(Float);
+  if (this->_mapping_size < expected) {
+    ::munmap(this->_mapping, this->_mapping_size);
+    this->_mapping = nullptr;
+    throw std::runtime_error("Truncated binary matrix file " + filepath);
+  }
+
+  // Training passes visit the rows in random order.
+  ::madvise(this->_mapping, this->_mapping_size, MADV_RANDOM);
+}
+
+void MappedMatrix::read_rows(const std::size_t first, const std::size_t count,
+                             Float* out) const {
+  if (first + count > this->_rows) {
+    throw std::out_of_range("Row index out of range.");
+  }
+  std::copy(this->row(first), this->row(first + count), out);
+}
+
+MappedMatrix::~MappedMatrix() {
+  if (this->_mapping != nullptr) {
+    ::munmap(this->_mapping, this->_mapping_size);
+  }
+}
+
+}  // namespace utils
+}  // namespace ado
@@ -0,0 +1,81 @@
+#include "ado/utils/row_cache.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ado {
+namespace utils {
+
+constexpr std::size_t RowCache::kNone;
+
+RowCache::RowCache(const RowSource& source, const std::size_t memory_budget)
+    : _source(source) {
+  const std::size_t row_bytes =
+      std::max<std::size_t>(1, source.cols()) * sizeof(Float);
+  this->_capacity = std::max<std::size_t>(
+      2, std::min(memory_budget / row_bytes, source.rows()));
+
+  this->_storage.resize(this->_capacity * source.cols());
+  this->_slot_row.assign(this->_capacity, kNone);
+  this->_prev.assign(this->_capacity, kNone);
+  this->_next.assign(this->_capacity, kNone);
+  this->_row_slot.assign(source.rows(), kNone);
+}
+
+const Float* RowCache::row(const std::size_t i) {
+  const auto n_cols = this->_source.cols();
+
+  if (i >= this->_row_slot.size()) {
+    throw std::out_of_range("Row index out of range.");
+  }
+
+  if (this->_row_slot[i] != kNone) {
+    ++this->_hits;
+    const auto slot = this->_row_slot[i];
+    if (slot != this->_head) {
+      this->unlink(slot);
+      this->push_front(slot);
+    }
+    return this->_storage.data() + slot * n_cols;
+  }
+
+  ++this->_misses;
+  std::size_t slot = this->_used;
+  if (this->_used < this->_capacity) {
+    ++this->_used;
+  } else {
+    // Evict the least recently used row.
+    slot = this->_tail;
+    this->unlink(slot);
+    this->_row_slot[this->_slot_row[slot]] = kNone;
+  }
+
+  Float* data = this->_storage.data() + slot * n_cols;
+  this->_source.read_rows(i, 1, data);
+  this->_slot_row[slot] = i;
+  this->_row_slot[i] = slot;
+  this->push_front(slot);
+  return data;
+}
+
+void RowCache::unlink(const std::size_t slot) {
+  const auto prev = this->_prev[slot];
+  const auto next = this->_next[slot];
+  if (prev != kNone) this->_next[prev] = next;
+  if (next != kNone) this->_prev[next] = prev;
+  if (this->_head == slot) this->_head = next;
+  if (this->_tail == slot) this->_tail = prev;
+  this->_prev[slot] = kNone;
+  this->_next[slot] = kNone;
+}
+
+void RowCache::push_front(const std::size_t slot) {
+  this->_prev[slot] = kNone;
+  this->_next[slot] = this->_head;
+  if (this->_head != kNone) this->_prev[this->_head] = slot;
+  this->_head = slot;
+  if (this->_tail == kNone) this->_tail = slot;
+}
+
+}  // namespace utils
+}  // namespace ado
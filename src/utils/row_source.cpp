@@ -0,0 +1,87 @@
+#include "ado/utils/row_source.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 2 * sizeof(std::uint64_t);
+
+// pread until the whole range is read.
+bool read_fully(const int fd, char* out, std::size_t size, off_t offset) {
+  while (size > 0) {
+    const auto n = ::pread(fd, out, size, offset);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    out += n;
+    size -= static_cast<std::size_t>(n);
+    offset += n;
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace ado {
+namespace utils {
+
+BinaryRowFile::BinaryRowFile(const std::string& filepath) {
+  this->_fd = ::open(filepath.c_str(), O_RDONLY);
+  if (this->_fd < 0) {
+    throw std::runtime_error("File does not exist !");
+  }
+
+  std::uint64_t header[2] = {0, 0};
+  if (!read_fully(this->_fd, reinterpret_cast<char*>(header), kHeaderSize,
+                  0)) {
+    ::close(this->_fd);
+    throw std::runtime_error("Invalid binary matrix file " + filepath);
+  }
+  this->_rows = static_cast<std::size_t>(header[0]);
+  this->_cols = static_cast<std::size_t>(header[1]);
+
+  // Checked before computing the expected size, which could wrap around.
+  // Past this point every row offset is bounded by the file size.
+  if (this->_cols != 0 &&
+      this->_rows > (SIZE_MAX - kHeaderSize) / sizeof(Float) / this->_cols) {
+    ::close(this->_fd);
+    throw std::runtime_error("Invalid binary matrix file " + filepath);
+  }
+
+  struct stat info;
+  const auto expected = kHeaderSize + this->_rows * this->_cols * sizeof(Float);
+  if (::fstat(this->_fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < expected) {
+    ::close(this->_fd);
+    throw std::runtime_error("Truncated binary matrix file " + filepath);
+  }
+
+  ::posix_fadvise(this->_fd, 0, 0, POSIX_FADV_RANDOM);
+}
+
+BinaryRowFile::~BinaryRowFile() {
+  if (this->_fd >= 0) {
+    ::close(this->_fd);
+  }
+}
+
+void BinaryRowFile::read_rows(const std::size_t first, const std::size_t count,
+                              Float* out) const {
+  if (first > this->_rows || count > this->_rows - first) {
+    throw std::out_of_range("Row index out of range.");
+  }
+  const auto row_size = this->_cols * sizeof(Float);
+  const auto offset = static_cast<off_t>(kHeaderSize + first * row_size);
+  if (!read_fully(this->_fd, reinterpret_cast<char*>(out), count * row_size,
+                  offset)) {
+    throw std::runtime_error("Unable to read the binary matrix file.");
+  }
+}
+
+}  // namespace utils
+}  // namespace ado
@@ -0,0 +1,258 @@
+#include "ado/utils/trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace {
+
+std::uint64_t steady_ns() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+#if defined(__linux__)
+int open_counter(const std::uint32_t config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Calling thread, any CPU.
+  return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::uint64_t read_counter(const int fd) {
+  std::uint64_t value = 0;
+  if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+    return 0;
+  }
+  return value;
+}
+
+void open_counters(ado::utils::TraceBuffer& buffer) {
+  buffer.cycles_fd = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+  buffer.cache_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+}
+
+void close_counter(const int fd) {
+  if (fd >= 0) ::close(fd);
+}
+#else
+void open_counters(ado::utils::TraceBuffer&) {}
+std::uint64_t read_counter(const int) { return 0; }
+void close_counter(const int) {}
+#endif
+
+void write_json_string(std::ostream& output, const char* text) {
+  output << '"';
+  for (const char* c = text; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') output << '\\';
+    output << *c;
+  }
+  output << '"';
+}
+
+}  // namespace
+
+namespace ado {
+namespace utils {
+
+constexpr std::size_t TraceBuffer::kChunkEvents;
+
+TraceBuffer::TraceBuffer(const std::uint32_t thread_id,
+                         const std::size_t capacity)
+    : thread_id(thread_id),
+      capacity(capacity),
+      chunks(new std::atomic<TraceEvent*>[(capacity + kChunkEvents - 1) /
+                                          kChunkEvents]) {
+  for (std::size_t c = 0; c * kChunkEvents < capacity; ++c) {
+    this->chunks[c].store(nullptr);
+  }
+}
+
+TraceBuffer::~TraceBuffer() {
+  this->clear();
+  close_counter(this->cycles_fd);
+  close_counter(this->cache_misses_fd);
+}
+
+void TraceBuffer::push(const TraceEvent& event) {
+  const std::size_t size = this->size.load(std::memory_order_relaxed);
+  if (size == this->capacity) {
+    this->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto& slot = this->chunks[size / kChunkEvents];
+  TraceEvent* chunk = slot.load(std::memory_order_relaxed);
+  if (chunk == nullptr) {
+    // Called from span destructors, an allocation failure drops the event.
+    chunk = new (std::nothrow) TraceEvent[kChunkEvents];
+    if (chunk == nullptr) {
+      this->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    slot.store(chunk, std::memory_order_relaxed);
+  }
+  chunk[size % kChunkEvents] = event;
+  // Publishes the event and its chunk to the exporter.
+  this->size.store(size + 1, std::memory_order_release);
+}
+
+void TraceBuffer::clear() {
+  for (std::size_t c = 0; c * kChunkEvents < this->capacity; ++c) {
+    delete[] this->chunks[c].exchange(nullptr);
+  }
+  this->size.store(0);
+  this->dropped.store(0);
+}
+
+/**
+ * @brief Hands the buffer of a thread back to the tracer when it exits.
+ */
+struct TraceBufferHolder {
+  ~TraceBufferHolder() {
+    if (this->buffer != nullptr) Tracer::get().release(this->buffer);
+  }
+
+  TraceBuffer* buffer = nullptr;
+};
+
+Tracer& Tracer::get() {
+  static Tracer tracer;
+  return tracer;
+}
+
+Tracer::Tracer() : _origin(steady_ns()) {}
+
+void Tracer::enable_counters(const bool enabled) {
+  this->_counters.store(enabled);
+}
+
+void Tracer::set_capacity(const std::size_t capacity) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The trace capacity must be positive.");
+  }
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_capacity = capacity;
+}
+
+TraceBuffer& Tracer::buffer() {
+  // Owned by the tracer, so the events outlive the thread.
+  thread_local TraceBufferHolder holder;
+  if (holder.buffer != nullptr) return *holder.buffer;
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!this->_free.empty()) {
+    holder.buffer = this->_free.back();
+    this->_free.pop_back();
+  } else {
+    const auto thread_id = static_cast<std::uint32_t>(this->_buffers.size());
+    this->_buffers.push_back(
+        std::make_unique<TraceBuffer>(thread_id, this->_capacity));
+    holder.buffer = this->_buffers.back().get();
+  }
+
+  // The counters measure the thread that opens them.
+  if (this->_counters.load()) open_counters(*holder.buffer);
+  return *holder.buffer;
+}
+
+void Tracer::release(TraceBuffer* buffer) {
+  close_counter(buffer->cycles_fd);
+  close_counter(buffer->cache_misses_fd);
+  buffer->cycles_fd = -1;
+  buffer->cache_misses_fd = -1;
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_free.push_back(buffer);
+}
+
+std::uint64_t Tracer::now() const { return steady_ns() - this->_origin; }
+
+std::string Tracer::chrome_trace() const {
+  std::ostringstream output;
+  // Timestamps in microseconds, with a nanosecond resolution.
+  output << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+  bool first = true;
+  std::size_t dropped = 0;
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  for (const auto& buffer : this->_buffers) {
+    const std::size_t size = buffer->size.load(std::memory_order_acquire);
+    dropped += buffer->dropped.load();
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto& event = buffer->event(i);
+      output << (first ? "\n" : ",\n") << "{\"name\":";
+      write_json_string(output, event.name);
+      output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+             << ",\"ts\":" << event.start_ns / 1e3
+             << ",\"dur\":" << event.duration_ns / 1e3;
+      if (event.counted) {
+        output << ",\"args\":{\"cycles\":" << event.cycles
+               << ",\"cache_misses\":" << event.cache_misses << "}";
+      }
+      output << "}";
+      first = false;
+    }
+  }
+
+  output << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":"
+         << dropped << "}}\n";
+  return output.str();
+}
+
+void Tracer::write_chrome_trace(const std::string& filepath) const {
+  std::ofstream output(filepath);
+  if (!output) {
+    throw std::runtime_error("Unable to open file " + filepath);
+  }
+  output << this->chrome_trace();
+}
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  for (auto& buffer : this->_buffers) {
+    buffer->clear();
+  }
+}
+
+TraceSpan::TraceSpan(const char* name)
+    : _buffer(Tracer::get().buffer()), _name(name) {
+  this->_cycles = read_counter(this->_buffer.cycles_fd);
+  this->_cache_misses = read_counter(this->_buffer.cache_misses_fd);
+  this->_start = Tracer::get().now();
+}
+
+TraceSpan::~TraceSpan() {
+  const auto end = Tracer::get().now();
+  const auto cycles = read_counter(this->_buffer.cycles_fd);
+  const auto cache_misses = read_counter(this->_buffer.cache_misses_fd);
+
+  // A reused buffer may hold the events of a previous owner with or without
+  // counters, so every event records whether it carries counter values.
+  const bool counted =
+      this->_buffer.cycles_fd >= 0 || this->_buffer.cache_misses_fd >= 0;
+  this->_buffer.push(TraceEvent{this->_name, this->_start,
+                                end - this->_start, cycles - this->_cycles,
+                                cache_misses - this->_cache_misses, counted});
+}
+
+}  // namespace utils
+}  // namespace ado
@@ -0,0 +1,104 @@
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "ado/core/serialization.h"
+#include "ado/core/svm.h"
+#include "ado/serving/file_scoring.h"
+#include "ado/utils/logger.h"
+
+using ado::core::load_model;
+using ado::core::SVM;
+using ado::serving::FileScoringOptions;
+using ado::serving::predict_file;
+using ado::utils::Logger;
+using ado::utils::LogLevel;
+using ado::utils::LogStreamHandler;
+
+namespace {
+
+void usage() {
+  std::cerr << "Usage: ado-predict --model FILE --input CSV --output FILE\n"
+               "                   [--chunk-rows ROWS] [--buffers N] "
+               "[--scorers N]\n"
+               "                   [--decision-values]\n"
+               "\n"
+               "Score a CSV file with an SVM saved with ado::core::save_model, "
+               "streaming\nthe rows through overlapped read, score and write "
+               "threads.\n";
+}
+
+/**
+ * @brief Parse a whole argument as an unsigned count, false if it is not one.
+ */
+bool parse_count(const std::string& value, std::size_t& count) {
+  try {
+    std::size_t end = 0;
+    const unsigned long parsed = std::stoul(value, &end);
+    if (end != value.size() || value[0] == '-') return false;
+    count = parsed;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto& logger = Logger::get();
+  logger.register_handler(std::make_unique<LogStreamHandler>(LogLevel::Info));
+
+  std::string model_path;
+  std::string input_path;
+  std::string output_path;
+  FileScoringOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--decision-values") {
+      options.decision_values = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return EXIT_FAILURE;
+    }
+    const std::string value = argv[++i];
+    bool parsed = true;
+    if (arg == "--model") {
+      model_path = value;
+    } else if (arg == "--input") {
+      input_path = value;
+    } else if (arg == "--output") {
+      output_path = value;
+    } else if (arg == "--chunk-rows") {
+      parsed = parse_count(value, options.chunk_rows);
+    } else if (arg == "--buffers") {
+      parsed = parse_count(value, options.n_buffers);
+    } else if (arg == "--scorers") {
+      parsed = parse_count(value, options.n_scorers);
+    } else {
+      parsed = false;
+    }
+    if (!parsed) {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (model_path.empty() || input_path.empty() || output_path.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const SVM svm = load_model(model_path);
+    predict_file(svm, input_path, output_path, options);
+  } catch (const std::exception& e) {
+    logger << LogLevel::Error << e.what();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
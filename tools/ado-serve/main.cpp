@@ -0,0 +1,185 @@
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ado/core/model_registry.h"
+#include "ado/core/serialization.h"
+#include "ado/core/svm.h"
+#include "ado/serving/server.h"
+#include "ado/utils/logger.h"
+
+using ado::core::load_model;
+using ado::core::ModelRegistry;
+using ado::core::SVM;
+using ado::serving::BatchOptions;
+using ado::serving::Server;
+using ado::utils::Logger;
+using ado::utils::LogLevel;
+using ado::utils::LogStreamHandler;
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+volatile std::sig_atomic_t g_reload = 0;
+
+void on_stop(int) { g_stop = 1; }
+void on_reload(int) { g_reload = 1; }
+
+void usage() {
+  std::cerr << "Usage: ado-serve --socket PATH --model NAME=FILE\n"
+               "                 [--model NAME=FILE ...] [--max-batch ROWS]\n"
+               "                 [--max-delay-us US] [--report-seconds S]\n"
+               "\n"
+               "Serve SVMs saved with ado::core::save_model. SIGHUP reloads "
+               "the model files,\nSIGINT and SIGTERM stop the server.\n";
+}
+
+/**
+ * @brief Parse a whole argument as an unsigned count, false if it is not one
+ * or does not fit a long.
+ */
+bool parse_count(const std::string& value, std::size_t& count) {
+  try {
+    std::size_t end = 0;
+    const unsigned long parsed = std::stoul(value, &end);
+    if (end != value.size() || value[0] == '-' ||
+        parsed > static_cast<unsigned long>(std::numeric_limits<long>::max())) {
+      return false;
+    }
+    count = parsed;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+using ModelFiles = std::vector<std::pair<std::string, std::string>>;
+
+void load_models(ModelRegistry& registry, const ModelFiles& files) {
+  auto& logger = Logger::get();
+  for (const auto& file : files) {
+    registry.publish(file.first,
+                     std::make_shared<const SVM>(load_model(file.second)));
+    logger << LogLevel::Info << "Loaded model " << file.first << " from "
+           << file.second << ".";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto& logger = Logger::get();
+  logger.register_handler(std::make_unique<LogStreamHandler>(LogLevel::Info));
+
+  std::string socket_path;
+  ModelFiles files;
+  BatchOptions options;
+  std::size_t max_delay_us = 500;
+  std::size_t report_seconds = 60;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      usage();
+      return EXIT_FAILURE;
+    }
+    const std::string value = argv[++i];
+    bool parsed = true;
+    if (arg == "--socket") {
+      socket_path = value;
+    } else if (arg == "--model") {
+      const auto separator = value.find('=');
+      if (separator == std::string::npos) {
+        usage();
+        return EXIT_FAILURE;
+      }
+      files.emplace_back(value.substr(0, separator),
+                         value.substr(separator + 1));
+    } else if (arg == "--max-batch") {
+      parsed = parse_count(value, options.max_batch_rows) &&
+               options.max_batch_rows > 0;
+    } else if (arg == "--max-delay-us") {
+      parsed = parse_count(value, max_delay_us);
+    } else if (arg == "--report-seconds") {
+      parsed = parse_count(value, report_seconds);
+    } else {
+      parsed = false;
+    }
+    if (!parsed) {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (socket_path.empty() || files.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+  options.max_delay = std::chrono::microseconds(max_delay_us);
+
+  ModelRegistry registry;
+  std::vector<std::string> names;
+  try {
+    load_models(registry, files);
+  } catch (const std::exception& e) {
+    logger << LogLevel::Error << e.what();
+    return EXIT_FAILURE;
+  }
+  for (const auto& file : files) {
+    names.push_back(file.first);
+  }
+
+  std::signal(SIGINT, on_stop);
+  std::signal(SIGTERM, on_stop);
+  std::signal(SIGHUP, on_reload);
+
+  std::unique_ptr<Server> server;
+  try {
+    server = std::make_unique<Server>(socket_path, registry, names, options,
+                                      std::chrono::seconds(report_seconds));
+  } catch (const std::exception& e) {
+    logger << LogLevel::Error << e.what();
+    return EXIT_FAILURE;
+  }
+
+  std::exception_ptr error;
+  std::thread serving([&server, &error]() {
+    try {
+      server->run();
+    } catch (...) {
+      error = std::current_exception();
+      g_stop = 1;
+    }
+  });
+
+  // Signals are only flagged by the handlers, act on them here.
+  while (!g_stop) {
+    if (g_reload) {
+      g_reload = 0;
+      try {
+        load_models(registry, files);
+      } catch (const std::exception& e) {
+        logger << LogLevel::Error << "Reload failed: " << e.what();
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  server->stop();
+  serving.join();
+  if (error) {
+    try {
+      std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+      logger << LogLevel::Error << e.what();
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}